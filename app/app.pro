@@ -0,0 +1,43 @@
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+CONFIG += c++17
+
+TARGET = modelation_of_mirrors
+
+include(../core/core.pri)
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+    main.cpp \
+    mainwindow.cpp \
+    mirrorroom.cpp \
+    paintbenchmark.cpp \
+    roomrenderer.cpp \
+    traceworker.cpp \
+    walldialog.cpp
+
+HEADERS += \
+    mainwindow.h \
+    mirrorroom.h \
+    paintbenchmark.h \
+    roomrenderer.h \
+    traceworker.h \
+    walldialog.h
+
+FORMS += \
+    mainwindow.ui
+
+TRANSLATIONS += \
+    modelation_of_mirrors_ru_RU.ts
+CONFIG += lrelease
+CONFIG += embed_translations
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
@@ -0,0 +1,32 @@
+#include <QApplication>
+#include <QSurfaceFormat>
+#include "mainwindow.h"
+#include "paintbenchmark.h"
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+
+    // Set application properties
+    app.setApplicationName("Mirror Room Optical Experiments");
+    app.setApplicationVersion("1.0");
+    app.setOrganizationName("OpticalLab");
+
+    // Замеры отрисовки без окна: шрифты и растеризатор уже доступны после QApplication
+    if (app.arguments().contains("--paint-benchmark")) {
+        QTextStream out(stdout);
+        runPaintBenchmark(out);
+        return 0;
+    }
+
+    // Set OpenGL format if needed for better rendering
+    QSurfaceFormat format;
+    format.setSamples(4); // Multisampling for smoother lines
+    QSurfaceFormat::setDefaultFormat(format);
+
+    // Create and show main window
+    MainWindow mainWindow;
+    mainWindow.show();
+
+    return app.exec();
+}
@@ -0,0 +1,766 @@
+#include "mirrorroom.h"
+#include "roombuilder.h"
+#include <QFontMetrics>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QTimer>
+#include <cmath>
+#include <QMessageBox>
+
+namespace {
+// Сколько поток GUI трассирует предпросмотр на одно движение мыши: вместе с отрисовкой
+// кадр остается в 16 мс (см. mirrortrace --benchmark)
+const qint64 PreviewFrameBudget = 4000000;
+// Предпросмотр длиннее не досчитывается: столько отрезков еще рисуется за кадр
+const int PreviewMaxReflections = 10000;
+// Сколько точек пути дорисовывается в картинку луча за кадр; остаток - следующими кадрами
+const int RayLayerPointsPerFrame = 20000;
+}
+
+MirrorRoom::MirrorRoom(QWidget *parent)
+    : QWidget(parent)
+    , m_creationMode(DrawByClick)
+    , m_tracingBackend(WallIndex::UniformGrid)
+    , m_currentRay(nullptr)
+    , m_maxReflections(50)
+    , m_regularWallsCount(4)
+    , m_roomCompleted(false)
+    , m_selectingStartPoint(false)
+    , m_selectingAngle(false)
+    , m_currentAngle(0.0) // 0° - вправо
+    , m_rayLayerPending(false)
+    , m_previewRay(nullptr)
+    , m_maxPreviewLatency(0.0)
+{
+    setMinimumSize(600, 500);
+    setMouseTracking(true);
+
+    connect(&m_traceWorker, &TraceWorker::rayTraced, this, &MirrorRoom::onRayTraced);
+    connect(&m_previewWorker, &TraceWorker::rayTraced, this, &MirrorRoom::onPreviewTraced);
+}
+
+MirrorRoom::~MirrorRoom()
+{
+    m_previewWorker.cancel();
+    delete m_previewRay;
+    delete m_currentRay;
+    qDeleteAll(m_walls);
+}
+
+void MirrorRoom::setRoomCreationMode(MirrorRoom::RoomCreationMode mode)
+{
+    m_creationMode = mode;
+    clearRoom();
+}
+
+void MirrorRoom::setNumberOfWalls(int count)
+{
+    if (count >= 4 && count <= 9) {
+        m_regularWallsCount = count;
+        if (m_creationMode == RegularPolygon) {
+            clearRoom();
+            createRegularPolygon();
+        }
+    }
+}
+
+void MirrorRoom::setTracingBackend(WallIndex::Backend backend)
+{
+    if (backend == m_tracingBackend) return;
+    m_tracingBackend = backend;
+
+    // Пути от структуры не зависят: лучи переходят на новый индекс, текущий досчитывается с ним
+    if (m_traceRoom) {
+        m_traceRoom = QSharedPointer<const TraceRoom>(new TraceRoom(m_walls, m_tracingBackend));
+        attachRays();
+    }
+    startTracing();
+}
+
+void MirrorRoom::setMaxReflections(int count)
+{
+    if (count < 1 || count == m_maxReflections) return;
+    m_maxReflections = count;
+
+    // Путь текущего луча продолжается с последнего отражения, а не строится заново
+    if (m_currentRay) {
+        m_currentRay->setMaxReflections(m_maxReflections);
+        startTracing();
+        scheduleRayLayer();
+    }
+}
+
+void MirrorRoom::updateWallConfiguration()
+{
+    // Тип зеркала меняет геометрию дуги, поэтому перестраиваются и таблица, и индекс
+    if (m_roomCompleted) {
+        rebuildWallTable();
+    }
+    update();
+}
+
+void MirrorRoom::rebuildWallTable()
+{
+    // Правленые стены - по ревизиям; если изменился сам набор стен, путь пересчитывается целиком
+    bool sameWalls = m_wallRevisions.size() == m_walls.size();
+    QVector<int> changedWalls;
+    for (int i = 0; sameWalls && i < m_walls.size(); ++i) {
+        if (m_walls[i]->revision() != m_wallRevisions[i]) changedWalls.append(i);
+    }
+
+    // Одна таблица и один индекс на ревизию стен; поток, который еще считает по старым,
+    // держит их до конца своего запроса
+    m_traceRoom = QSharedPointer<const TraceRoom>(new TraceRoom(m_walls, m_tracingBackend));
+    m_roomHash = m_traceRoom->table.hash();
+    m_wallRevisions = wallRevisions();
+    attachRays();
+
+    // Луч после правки одной стены досчитывается с первого отрезка, который ее касается.
+    // Поток трассировки считает по старой комнате, поэтому запрос перезапускается всегда
+    if (m_currentRay) {
+        // Путь после правленой стены другой: нарисованное не годится
+        resetRayLayer();
+        if (!sameWalls) {
+            m_currentRay->invalidatePath();
+        }
+        for (int wall : changedWalls) {
+            m_currentRay->wallChanged(wall);
+        }
+        startTracing();
+        update();
+    }
+}
+
+void MirrorRoom::attachRays()
+{
+    // Лучи GUI читают таблицу и индекс текущей комнаты, как и потоки трассировки
+    for (LightRay* ray : {m_currentRay, m_previewRay}) {
+        if (ray) {
+            ray->setWallTable(m_traceRoom->table);
+            ray->setWallIndex(m_traceRoom->index);
+        }
+    }
+}
+
+QVector<quint64> MirrorRoom::wallRevisions() const
+{
+    QVector<quint64> revisions;
+    revisions.reserve(m_walls.size());
+    for (Wall* wall : m_walls) {
+        revisions.append(wall->revision());
+    }
+    return revisions;
+}
+
+bool MirrorRoom::wallsChanged(const QVector<quint64>& revisions) const
+{
+    if (revisions.size() != m_walls.size()) return true;
+    for (int i = 0; i < m_walls.size(); ++i) {
+        if (m_walls[i]->revision() != revisions[i]) return true;
+    }
+    return false;
+}
+
+void MirrorRoom::startTracing()
+{
+    // Поток GUI сам не трассирует: путь досчитывает TraceWorker, хвосты приходят в onRayTraced()
+    if (m_currentRay && !m_currentRay->complete()) {
+        m_traceWorker.start(*m_currentRay, m_traceRoom);
+    } else {
+        m_traceWorker.cancel();
+    }
+}
+
+void MirrorRoom::onRayTraced()
+{
+    if (!m_currentRay) return;
+
+    // Хвосты идут по порядку; чужой хвост (луч уже заменен или обрезан) не продолжает путь
+    bool appended = false;
+    for (const LightRay::Tail& tail : m_traceWorker.takeTails()) {
+        appended = m_currentRay->appendTail(tail) || appended;
+    }
+    if (appended) {
+        scheduleRayLayer();
+    }
+}
+
+void MirrorRoom::updatePreview()
+{
+    if (!m_selectingAngle || !m_roomCompleted || m_rayStartPoint.isNull() || m_walls.isEmpty()) {
+        clearPreview();
+        return;
+    }
+
+    if (wallsChanged(m_wallRevisions)) {
+        rebuildWallTable();
+    }
+
+    // Прежний предпросмотр устарел вместе с недосчитанными хвостами: start() ниже их отменит.
+    // Луч один на весь выбор угла - движение мыши лишь переставляет его старт
+    int previewReflections = qMin(m_maxReflections, PreviewMaxReflections);
+    if (!m_previewRay) {
+        m_previewRay = new LightRay(m_rayStartPoint, qDegreesToRadians(m_currentAngle), m_traceRoom->table,
+                                    m_traceRoom->index, previewReflections);
+    } else {
+        m_previewRay->setStart(m_rayStartPoint, qDegreesToRadians(m_currentAngle));
+        m_previewRay->setMaxReflections(previewReflections);
+    }
+    m_previewRay->traceFor(PreviewFrameBudget);
+    m_previewBounds = QRectF();
+    addPreviewBounds(m_previewRay->tracedPath());
+
+    if (m_previewRay->complete()) {
+        m_previewWorker.cancel();
+    } else {
+        m_previewWorker.start(*m_previewRay, m_traceRoom);
+    }
+}
+
+void MirrorRoom::clearPreview()
+{
+    m_previewWorker.cancel();
+    delete m_previewRay;
+    m_previewRay = nullptr;
+    m_previewBounds = QRectF();
+    m_previewLatency.invalidate();
+    m_maxPreviewLatency = 0.0;
+}
+
+void MirrorRoom::addPreviewBounds(const QVector<QPointF>& points)
+{
+    // QRectF::united() пропускает вырожденные прямоугольники, поэтому охват собирается по координатам
+    if (points.isEmpty()) return;
+    double left = points.first().x(), right = left;
+    double top = points.first().y(), bottom = top;
+    if (!m_previewBounds.isNull()) {
+        left = m_previewBounds.left();
+        right = m_previewBounds.right();
+        top = m_previewBounds.top();
+        bottom = m_previewBounds.bottom();
+    }
+    for (const QPointF& point : points) {
+        left = qMin(left, point.x());
+        right = qMax(right, point.x());
+        top = qMin(top, point.y());
+        bottom = qMax(bottom, point.y());
+    }
+    m_previewBounds = QRectF(QPointF(left, top), QPointF(right, bottom));
+}
+
+void MirrorRoom::onPreviewTraced()
+{
+    if (!m_previewRay) return;
+
+    bool appended = false;
+    for (const LightRay::Tail& tail : m_previewWorker.takeTails()) {
+        if (m_previewRay->appendTail(tail)) {
+            addPreviewBounds(tail.points);
+            appended = true;
+        }
+    }
+    if (appended) {
+        updateOverlay();
+    }
+}
+
+void MirrorRoom::startRayExperiment(const QPointF& startPoint, double angle)
+{
+    if (m_roomCompleted && !m_walls.isEmpty()) {
+        traceRay(startPoint, angle);
+    }
+}
+
+void MirrorRoom::startRayExperiment(double angle)
+{
+    if (m_roomCompleted && !m_walls.isEmpty() && !m_rayStartPoint.isNull()) {
+        traceRay(m_rayStartPoint, angle);
+    }
+}
+
+void MirrorRoom::traceRay(const QPointF& startPoint, double angle)
+{
+    // Угол передается в радианах, 0 - вправо, увеличение против часовой стрелки
+    double startAngle = qDegreesToRadians(angle);
+
+    // Стену поменяли в обход updateWallConfiguration(): хэш комнаты и луч - по новым стенам
+    if (wallsChanged(m_wallRevisions)) {
+        rebuildWallTable();
+    }
+
+    // Тот же эксперимент: путь продолжается с последнего отражения
+    if (m_currentRay && m_currentRay->startPoint() == startPoint && m_currentRay->startAngle() == startAngle) {
+        m_currentRay->setMaxReflections(m_maxReflections);
+        startTracing();
+        scheduleRayLayer();
+        return;
+    }
+
+    // Уходящий луч - в кэш, новый - из кэша, если его уже трассировали в этой комнате
+    if (m_currentRay) {
+        m_traceCache.insert(TraceCache::Key{m_roomHash, m_currentRay->startPoint(), m_currentRay->startAngle(),
+                                            m_currentRay->maxReflections()}, *m_currentRay);
+        delete m_currentRay;
+    }
+    const LightRay* cached = m_traceCache.find(TraceCache::Key{m_roomHash, startPoint, startAngle, m_maxReflections});
+    if (cached) {
+        // Копия из кэша смотрит в таблицу, по которой считалась; стены те же (ключ - хэш комнаты)
+        m_currentRay = new LightRay(*cached);
+        m_currentRay->setWallTable(m_traceRoom->table);
+        m_currentRay->setWallIndex(m_traceRoom->index);
+    } else {
+        m_currentRay = new LightRay(startPoint, startAngle, m_traceRoom->table, m_traceRoom->index,
+                                    m_maxReflections);
+    }
+    resetRayLayer();
+    startTracing();
+    update();
+}
+
+void MirrorRoom::clearRoom()
+{
+    clearPreview();
+    m_traceWorker.cancel();
+    delete m_currentRay;
+    m_currentRay = nullptr;
+    m_rayLayer = QImage();
+    m_rayLod = RoomRenderer::RayLod();
+    m_traceRoom.clear();
+    qDeleteAll(m_walls);
+    m_walls.clear();
+    m_wallLayer = QImage();
+    m_wallLayerRevisions.clear();
+    m_tempPoints.clear();
+    m_roomCompleted = false;
+    m_rayStartPoint = QPointF();
+    m_selectingStartPoint = false;
+    m_selectingAngle = false;
+    m_currentAngle = 0.0;
+    update();
+}
+
+void MirrorRoom::paintEvent(QPaintEvent *event)
+{
+    // Рисование обрезается по обновляемой области; exposed - ее охватывающий прямоугольник,
+    // по нему отбрасываются стены и отрезки луча, которые в область не попадают
+    QRect exposed = event->rect();
+    QPainter painter(this);
+    painter.setClipRegion(event->region());
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    if (!m_roomCompleted) {
+        // Draw background
+        painter.fillRect(exposed, Qt::white);
+
+        // Draw temporary points during room creation
+        painter.setPen(QPen(Qt::blue, 3));
+        painter.setBrush(Qt::blue);
+
+        for (const QPointF& point : m_tempPoints) {
+            painter.drawEllipse(point, 6, 6);
+        }
+
+        // Draw connecting lines
+        if (m_tempPoints.size() > 1) {
+            painter.setPen(QPen(Qt::blue, 2, Qt::DashLine));
+            for (int i = 1; i < m_tempPoints.size(); ++i) {
+                painter.drawLine(m_tempPoints[i-1], m_tempPoints[i]);
+            }
+
+            // Draw line back to first point if we have at least 3 points
+            if (m_tempPoints.size() >= 3) {
+                painter.drawLine(m_tempPoints.last(), m_tempPoints.first());
+            }
+        }
+    } else {
+        // Фон вместе со стенами - одной готовой картинкой
+        drawWalls(painter, exposed);
+
+        if (m_currentRay) {
+            drawRay(painter, exposed);
+        }
+    }
+
+    // Draw start point and trajectory
+    drawStartPointAndTrajectory(painter);
+
+    if (m_selectingAngle && !m_rayStartPoint.isNull()) {
+        if (m_previewRay) {
+            m_renderer.drawPreview(painter, *m_previewRay, exposed);
+        }
+        drawAngleSelection(painter);
+    }
+    m_paintedOverlay = overlayRect();
+
+    if (m_previewLatency.isValid()) {
+        double milliseconds = m_previewLatency.nsecsElapsed() / 1e6;
+        m_previewLatency.invalidate();
+        m_maxPreviewLatency = qMax(m_maxPreviewLatency, milliseconds);
+        emit previewFrameMeasured(milliseconds, m_maxPreviewLatency);
+    }
+}
+
+QRect MirrorRoom::overlayRect() const
+{
+    if (m_rayStartPoint.isNull()) return QRect();
+
+    // Точка старта с обводкой
+    QRectF bounds(m_rayStartPoint - QPointF(10, 10), m_rayStartPoint + QPointF(10, 10));
+
+    // Линия со стрелкой и подпись угла: тот же расчет, что в drawStartPointAndTrajectory
+    // и drawAngleSelection; запас 15 покрывает крылья стрелки и перо
+    QString angleText = QString("%1°").arg(qRound(m_currentAngle));
+    QFontMetrics metrics(QFont("Arial", 10, QFont::Bold));
+    auto addArrow = [&](const QPointF& from, const QPointF& tip, const QPointF& label) {
+        bounds |= QRectF(from, tip).normalized().adjusted(-15, -15, 15, 15);
+        bounds |= QRectF(metrics.boundingRect(angleText)).translated(label);
+    };
+
+    if (!m_selectingAngle) {
+        QPointF tip = m_rayStartPoint + calculateDirectionVector(m_currentAngle) * 80;
+        addArrow(m_rayStartPoint, tip, tip + QPointF(10, -10));
+    } else if (!m_angleSelectionPoint.isNull()) {
+        addArrow(m_rayStartPoint, m_angleSelectionPoint, m_angleSelectionPoint + QPointF(10, -10));
+    }
+
+    // Траектория предпросмотра
+    if (m_previewRay && !m_previewBounds.isNull()) {
+        bounds |= m_previewBounds;
+    }
+
+    // Сглаживание выходит за геометрию на пиксель
+    return bounds.toAlignedRect().adjusted(-2, -2, 2, 2);
+}
+
+void MirrorRoom::updateOverlay()
+{
+    // Старое место стирается, новое рисуется; промежуточные состояния между кадрами
+    // не рисовались, поэтому достаточно того, что стоит на экране сейчас
+    update(m_paintedOverlay.united(overlayRect()));
+}
+
+void MirrorRoom::mousePressEvent(QMouseEvent *event)
+{
+    QPointF clickPos = event->pos();
+
+    if (m_selectingStartPoint && m_roomCompleted) {
+        // Ищем стену, на которую кликнули
+        Wall* wall = findWallAtPoint(clickPos);
+        if (wall) {
+            // Находим ближайшую точку на ВСЕЙ СТЕНЕ
+            m_rayStartPoint = wall->getClosestPoint(clickPos);
+            m_selectingStartPoint = false;
+            m_selectingAngle = true;
+            // Начальное направление - вправо (0°)
+            m_angleSelectionPoint = m_rayStartPoint + QPointF(50, 0);
+            m_currentAngle = 0.0;
+            updatePreview();
+            updateOverlay();
+        } else {
+            QMessageBox::warning(this, "Selection Error",
+                                 "Please click on a wall to select the starting point.");
+        }
+        return;
+    } else if (m_selectingAngle && m_roomCompleted) {
+        // Завершаем выбор угла
+        m_currentAngle = calculateAngle(m_rayStartPoint, clickPos);
+        m_selectingAngle = false;
+        clearPreview();
+        updateOverlay();
+        return;
+    }
+
+    if (m_creationMode == DrawByClick && !m_roomCompleted) {
+        // Проверяем, не закрываем ли многоугольник
+        if (m_tempPoints.size() >= 3 && QLineF(clickPos, m_tempPoints.first()).length() < 25) {
+            if (m_tempPoints.size() >= 4) {
+                completeRoom();
+            } else {
+                QMessageBox::warning(this, "Room Creation",
+                                     "Room must have at least 4 walls. Please add more points.");
+                return;
+            }
+        } else {
+            m_tempPoints.append(clickPos);
+        }
+        update();
+    } else if (m_roomCompleted) {
+        // Handle wall selection for configuration - РАБОТАЕТ ПО ВСЕЙ СТЕНЕ
+        for (int i = 0; i < m_walls.size(); ++i) {
+            if (m_walls[i]->containsPoint(clickPos)) {
+                emit wallSelected(i);
+                update();
+                break;
+            }
+        }
+    }
+}
+
+void MirrorRoom::mouseMoveEvent(QMouseEvent *event)
+{
+    if (m_selectingAngle && !m_rayStartPoint.isNull()) {
+        m_angleSelectionPoint = event->pos();
+        // Обновляем угол в реальном времени при перемещении мыши
+        m_currentAngle = calculateAngle(m_rayStartPoint, m_angleSelectionPoint);
+        m_previewLatency.start();
+        updatePreview();
+        updateOverlay();
+    }
+    QWidget::mouseMoveEvent(event);
+}
+
+Wall* MirrorRoom::findWallAtPoint(const QPointF& point) const
+{
+    for (Wall* wall : m_walls) {
+        if (wall->containsPoint(point)) {
+            return wall;
+        }
+    }
+    return nullptr;
+}
+
+double MirrorRoom::calculateAngle(const QPointF& start, const QPointF& end) const
+{
+    QLineF line(start, end);
+    double dx = line.dx();
+    double dy = line.dy();
+
+    // Вычисляем угол в радианах
+    double angleRad = atan2(dy, dx);
+
+    // Преобразуем в градусы
+    double angleDeg = angleRad * 180.0 / M_PI;
+
+    // Нормализуем угол в диапазон [0, 360)
+    if (angleDeg < 0) {
+        angleDeg += 360.0;
+    }
+
+    return angleDeg;
+}
+
+QPointF MirrorRoom::calculateDirectionVector(double angle) const
+{
+    // Преобразуем угол в радианы
+    double angleRad = qDegreesToRadians(angle);
+
+    // Вычисляем вектор направления
+    return QPointF(cos(angleRad), sin(angleRad));
+}
+
+void MirrorRoom::drawAngleSelection(QPainter& painter)
+{
+    if (m_rayStartPoint.isNull() || m_angleSelectionPoint.isNull()) return;
+
+    // Рисуем линию выбора угла
+    painter.setPen(QPen(Qt::red, 3, Qt::SolidLine));
+    painter.drawLine(m_rayStartPoint, m_angleSelectionPoint);
+
+    // Рисуем стрелку направления
+    QLineF directionLine(m_rayStartPoint, m_angleSelectionPoint);
+    if (directionLine.length() > 40) {
+        directionLine.setLength(40);
+    }
+
+    // Вычисляем угол для стрелки
+    double angleRad = qDegreesToRadians(m_currentAngle);
+
+    // Вычисляем точки стрелки
+    QPointF arrowTip = directionLine.p2();
+    QPointF arrowLeft = arrowTip + QPointF(cos(angleRad + 2.5) * 12,
+                                           sin(angleRad + 2.5) * 12);
+    QPointF arrowRight = arrowTip + QPointF(cos(angleRad - 2.5) * 12,
+                                            sin(angleRad - 2.5) * 12);
+
+    painter.drawLine(arrowTip, arrowLeft);
+    painter.drawLine(arrowTip, arrowRight);
+
+    // Показываем угол
+    QString angleText = QString("%1°").arg(qRound(m_currentAngle));
+    painter.setPen(Qt::darkRed);
+    painter.setFont(QFont("Arial", 10, QFont::Bold));
+    painter.drawText(m_angleSelectionPoint + QPointF(10, -10), angleText);
+}
+
+void MirrorRoom::drawStartPointAndTrajectory(QPainter& painter)
+{
+    if (!m_rayStartPoint.isNull()) {
+        // Рисуем точку старта
+        painter.setBrush(Qt::red);
+        painter.setPen(QPen(Qt::darkRed, 2));
+        painter.drawEllipse(m_rayStartPoint, 8, 8);
+
+        // Рисуем крестик внутри точки
+        painter.setPen(QPen(Qt::white, 2));
+        painter.drawLine(m_rayStartPoint - QPointF(5, 0), m_rayStartPoint + QPointF(5, 0));
+        painter.drawLine(m_rayStartPoint - QPointF(0, 5), m_rayStartPoint + QPointF(0, 5));
+
+        // Рисуем фиксированную траекторию
+        if (!m_selectingAngle) {
+            QPointF direction = calculateDirectionVector(m_currentAngle);
+            QLineF trajectory(m_rayStartPoint, m_rayStartPoint + direction * 80);
+
+            painter.setPen(QPen(Qt::red, 2, Qt::SolidLine));
+            painter.drawLine(trajectory);
+
+            // Рисуем стрелку на конце траектории
+            QPointF arrowTip = trajectory.p2();
+            double angleRad = qDegreesToRadians(m_currentAngle);
+
+            QPointF arrowLeft = arrowTip + QPointF(cos(angleRad + 2.5) * 12,
+                                                   sin(angleRad + 2.5) * 12);
+            QPointF arrowRight = arrowTip + QPointF(cos(angleRad - 2.5) * 12,
+                                                    sin(angleRad - 2.5) * 12);
+
+            painter.drawLine(arrowTip, arrowLeft);
+            painter.drawLine(arrowTip, arrowRight);
+
+            // Показываем угол
+            QString angleText = QString("%1°").arg(qRound(m_currentAngle));
+            painter.setPen(Qt::darkRed);
+            painter.setFont(QFont("Arial", 10, QFont::Bold));
+            painter.drawText(arrowTip + QPointF(10, -10), angleText);
+        }
+    }
+}
+
+void MirrorRoom::createRegularPolygon()
+{
+    QRect area = rect().adjusted(100, 100, -100, -100);
+    double radius = qMin(area.width(), area.height()) / 2.5;
+
+    m_tempPoints = RoomBuilder::regularPolygon(m_regularWallsCount, QPointF(area.center()), radius);
+
+    completeRoom();
+}
+
+void MirrorRoom::setRoomVertices(const QVector<QPointF>& vertices)
+{
+    clearRoom();
+    m_tempPoints = vertices;
+    completeRoom();
+}
+
+void MirrorRoom::completeRoom()
+{
+    if (m_tempPoints.size() < 4) {
+        QMessageBox::warning(this, "Room Creation",
+                             "Room must have at least 4 walls. Please add more points.");
+        return;
+    }
+
+    qDeleteAll(m_walls);
+    m_walls.clear();
+
+    // Create walls from points
+    m_walls = RoomBuilder::createWalls(m_tempPoints);
+
+    // Таблица стен для трассировки и структура для поиска следующей стены;
+    // концы стен после этого не меняются
+    rebuildWallTable();
+
+    m_roomCompleted = true;
+    update();
+}
+
+void MirrorRoom::drawWalls(QPainter& painter, const QRect& exposed)
+{
+    // Стены с подписями рисуются один раз в картинку размером с виджет в физических пикселях,
+    // кадр только копирует ее. Картинка перерисовывается, когда меняются стены
+    // (по Wall::revision(), даже без updateWallConfiguration()), размер или DPR экрана
+    qreal ratio = devicePixelRatioF();
+    QSize pixels = (QSizeF(size()) * ratio).toSize();
+    if (m_wallLayer.size() != pixels || m_wallLayer.devicePixelRatio() != ratio
+        || wallsChanged(m_wallLayerRevisions)) {
+        // Непрозрачный формат: копирование в кадр идет без смешивания
+        m_wallLayer = QImage(pixels, QImage::Format_RGB32);
+        m_wallLayer.setDevicePixelRatio(ratio);
+        m_wallLayer.fill(Qt::white);
+
+        QPainter layerPainter(&m_wallLayer);
+        layerPainter.setRenderHint(QPainter::Antialiasing);
+        m_renderer.drawWalls(layerPainter, m_walls);
+        m_wallLayerRevisions = wallRevisions();
+    }
+
+    // Копируется только открытая часть; картинка в физических пикселях
+    QRectF source(QPointF(exposed.topLeft()) * ratio, QSizeF(exposed.size()) * ratio);
+    painter.drawImage(QRectF(exposed), m_wallLayer, source);
+}
+
+void MirrorRoom::drawRay(QPainter& painter, const QRect& exposed)
+{
+    // Путь копится в картинке, как стены, и дорисовывается в drawRayLayer(); кадр только
+    // копирует открытую часть, поэтому время кадра не растет с длиной пути
+    qreal ratio = devicePixelRatioF();
+    QSize pixels = (QSizeF(size()) * ratio).toSize();
+    if (m_rayLayer.size() != pixels || m_rayLayer.devicePixelRatio() != ratio) {
+        // Картинка заводится заново только при смене размера или DPR, путь рисуется в нее с начала
+        m_rayLayer = QImage(pixels, QImage::Format_ARGB32_Premultiplied);
+        m_rayLayer.setDevicePixelRatio(ratio);
+        resetRayLayer();
+    }
+
+    QRectF source(QPointF(exposed.topLeft()) * ratio, QSizeF(exposed.size()) * ratio);
+    painter.drawImage(QRectF(exposed), m_rayLayer, source);
+}
+
+void MirrorRoom::resetRayLayer()
+{
+    // Другой луч или другой путь: картинка той же памяти очищается
+    m_rayLod = RoomRenderer::RayLod();
+    if (!m_rayLayer.isNull()) {
+        m_rayLayer.fill(Qt::transparent);
+    }
+    scheduleRayLayer();
+}
+
+void MirrorRoom::scheduleRayLayer()
+{
+    if (m_rayLayerPending) return;
+    m_rayLayerPending = true;
+    QTimer::singleShot(0, this, &MirrorRoom::drawRayLayer);
+}
+
+void MirrorRoom::drawRayLayer()
+{
+    m_rayLayerPending = false;
+    if (!m_currentRay || m_rayLayer.isNull()) return;
+
+    // Путь обрезали короче нарисованного: картинка строится заново, на экране - целиком
+    int count = m_currentRay->tracedPath().size();
+    if (m_rayLod.drawn > count) {
+        m_rayLod = RoomRenderer::RayLod();
+        m_rayLayer.fill(Qt::transparent);
+        update();
+    }
+    if (m_rayLod.drawn == count) return;
+
+    // Отсечение - по всему виджету: картинка хранит и то, что сейчас не открыто
+    QPainter layerPainter(&m_rayLayer);
+    layerPainter.setRenderHint(QPainter::Antialiasing);
+    QRectF drawn = m_renderer.drawRay(layerPainter, *m_currentRay, QRectF(rect()), m_rayLod,
+                                      RayLayerPointsPerFrame);
+    layerPainter.end();
+
+    if (!drawn.isEmpty()) {
+        update(drawn.toAlignedRect());
+    }
+    // Остаток длинного пути - следующим заходом, после отрисовки этого куска
+    if (m_rayLod.drawn < count) {
+        scheduleRayLayer();
+    }
+}
+
+void MirrorRoom::saveExperiment(const QString& filename)
+{
+    // TODO: Implement save functionality
+    Q_UNUSED(filename);
+}
+
+void MirrorRoom::loadExperiment(const QString& filename)
+{
+    // TODO: Implement load functionality
+    Q_UNUSED(filename);
+}
@@ -0,0 +1,154 @@
+#ifndef MIRRORROOM_H
+#define MIRRORROOM_H
+
+#include <QElapsedTimer>
+#include <QImage>
+#include <QWidget>
+#include <QVector>
+#include <QPointF>
+#include "wall.h"
+#include "lightray.h"
+#include "walltable.h"
+#include "wallindex.h"
+#include "roomrenderer.h"
+#include "tracecache.h"
+#include "traceworker.h"
+
+class MirrorRoom : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit MirrorRoom(QWidget *parent = nullptr);
+    ~MirrorRoom();
+
+    enum RoomCreationMode {
+        DrawByClick,
+        RegularPolygon
+    };
+
+public slots:
+    void setRoomCreationMode(MirrorRoom::RoomCreationMode mode);
+    void setNumberOfWalls(int count);
+    void setTracingBackend(WallIndex::Backend backend);
+    void setMaxReflections(int count);
+    void updateWallConfiguration();
+    void startRayExperiment(const QPointF& startPoint, double angle);
+    void startRayExperiment(double angle);
+    void clearRoom();
+    void saveExperiment(const QString& filename);
+    void loadExperiment(const QString& filename);
+    // Комната по готовым вершинам, как после замыкания кликами
+    void setRoomVertices(const QVector<QPointF>& vertices);
+
+    // Методы для доступа к стенам
+    Wall* getWall(int index) const {
+        return (index >= 0 && index < m_walls.size()) ? m_walls[index] : nullptr;
+    }
+    const QVector<Wall*>& getWalls() const { return m_walls; }
+
+    // Методы для установки режима выбора точки и угла
+    void setSelectingStartPoint(bool selecting) {
+        m_selectingStartPoint = selecting;
+        if (selecting) {
+            m_selectingAngle = false;
+            clearPreview();
+        }
+        updateOverlay();
+    }
+    void setSelectingAngle(bool selecting) {
+        m_selectingAngle = selecting;
+        if (selecting && !m_rayStartPoint.isNull()) {
+            // Начальное направление - вправо (0°)
+            m_angleSelectionPoint = m_rayStartPoint + QPointF(50, 0);
+        }
+        updatePreview();
+        updateOverlay();
+    }
+    void setCurrentAngle(double angle) {
+        m_currentAngle = angle;
+        updatePreview();
+        updateOverlay();
+    }
+    QPointF getRayStartPoint() const { return m_rayStartPoint; }
+    double getCurrentAngle() const { return m_currentAngle; }
+
+signals:
+    // Сигнал выбора стены
+    void wallSelected(int wallIndex);
+    // Задержка кадра предпросмотра: от движения мыши до конца отрисовки, и худшая за выбор угла
+    void previewFrameMeasured(double milliseconds, double maxMilliseconds);
+
+private slots:
+    void onRayTraced();
+    void onPreviewTraced();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+
+private:
+    RoomCreationMode m_creationMode;
+    QVector<Wall*> m_walls;
+    QSharedPointer<const TraceRoom> m_traceRoom;  // таблица и индекс текущих стен, общие с потоками
+    WallIndex::Backend m_tracingBackend;
+    QVector<QPointF> m_tempPoints;
+    LightRay* m_currentRay;
+    int m_maxReflections;
+    int m_regularWallsCount;
+    bool m_roomCompleted;
+    QPointF m_rayStartPoint;
+    bool m_selectingStartPoint;
+    bool m_selectingAngle;
+    QPointF m_angleSelectionPoint;
+    double m_currentAngle;
+    RoomRenderer m_renderer;
+    TraceCache m_traceCache;
+    TraceWorker m_traceWorker;
+    QByteArray m_roomHash;              // WallTable::hash() текущей таблицы
+    QVector<quint64> m_wallRevisions;   // Wall::revision() стен на момент постройки таблицы
+    QImage m_wallLayer;                 // фон и стены с подписями, в физических пикселях
+    QVector<quint64> m_wallLayerRevisions;  // Wall::revision() стен в m_wallLayer
+    QImage m_rayLayer;                  // нарисованный путь m_currentRay, прозрачный фон
+    RoomRenderer::RayLod m_rayLod;      // докуда путь нарисован в m_rayLayer
+    bool m_rayLayerPending;             // дорисовка m_rayLayer уже стоит в очереди событий
+    QRect m_paintedOverlay;             // где стоят точка старта и стрелка угла на экране сейчас
+    LightRay* m_previewRay;             // траектория под курсором, пока выбирается угол
+    TraceWorker m_previewWorker;
+    QRectF m_previewBounds;             // охват уже посчитанной части m_previewRay
+    QElapsedTimer m_previewLatency;     // запущен движением мыши, останавливается отрисовкой
+    double m_maxPreviewLatency;
+
+    void createRegularPolygon();
+    void completeRoom();
+    void rebuildWallTable();
+    void attachRays();
+    QVector<quint64> wallRevisions() const;
+    bool wallsChanged(const QVector<quint64>& revisions) const;
+    void startTracing();
+    void traceRay(const QPointF& startPoint, double angle);
+    // Точка старта, направление и стрелка выбора угла меняются часто: перерисовывается
+    // только объединение их прежнего и нового прямоугольников
+    QRect overlayRect() const;
+    void updateOverlay();
+    // Предпросмотр: первые отражения считаются сразу в пределах кадра, остальное - в потоке,
+    // пока мышь стоит; новое положение мыши отменяет недосчитанное
+    void updatePreview();
+    void clearPreview();
+    void addPreviewBounds(const QVector<QPointF>& points);
+    void drawWalls(QPainter& painter, const QRect& exposed);
+    void drawRay(QPainter& painter, const QRect& exposed);
+    // Картинка луча дорисовывается вне paintEvent кусками по RayLayerPointsPerFrame точек;
+    // перерисовывается только охват нового куска
+    void resetRayLayer();
+    void scheduleRayLayer();
+    void drawRayLayer();
+    void drawAngleSelection(QPainter& painter);
+    void drawStartPointAndTrajectory(QPainter& painter);
+    Wall* findWallAtPoint(const QPointF& point) const;
+    double calculateAngle(const QPointF& start, const QPointF& end) const;
+    QPointF calculateDirectionVector(double angle) const;
+};
+
+#endif // MIRRORROOM_H
@@ -0,0 +1,229 @@
+#include "paintbenchmark.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPaintDevice>
+#include <QPaintEngine>
+#include <QMouseEvent>
+#include <QPainter>
+#include <climits>
+#include <cmath>
+#include "lightray.h"
+#include "mirrorroom.h"
+#include "roombuilder.h"
+#include "roomrenderer.h"
+#include "walltable.h"
+
+namespace {
+
+const QSize FrameSize(800, 600);
+const double SecondsPerCase = 0.5;
+const int PreviewMoves = 100;
+
+// Движок, который ничего не рисует, а считает обращения QPainter к нему:
+// каждый вызов - отдельный проход растеризатора
+class CountingPaintEngine : public QPaintEngine
+{
+public:
+    CountingPaintEngine() : QPaintEngine(AllFeatures) {}
+
+    void reset() { calls = 0; primitives = 0; penChanges = 0; }
+
+    int calls = 0;
+    int primitives = 0;     // линий, фигур и надписей во всех вызовах
+    int penChanges = 0;
+
+    bool begin(QPaintDevice*) override { return true; }
+    bool end() override { return true; }
+    void updateState(const QPaintEngineState& state) override
+    {
+        if (state.state() & DirtyPen) ++penChanges;
+    }
+    void drawLines(const QLineF*, int lineCount) override { ++calls; primitives += lineCount; }
+    void drawLines(const QLine*, int lineCount) override { ++calls; primitives += lineCount; }
+    void drawRects(const QRectF*, int rectCount) override { ++calls; primitives += rectCount; }
+    void drawRects(const QRect*, int rectCount) override { ++calls; primitives += rectCount; }
+    void drawPoints(const QPointF*, int pointCount) override { ++calls; primitives += pointCount; }
+    void drawPoints(const QPoint*, int pointCount) override { ++calls; primitives += pointCount; }
+    void drawEllipse(const QRectF&) override { ++calls; ++primitives; }
+    void drawEllipse(const QRect&) override { ++calls; ++primitives; }
+    void drawPath(const QPainterPath&) override { ++calls; ++primitives; }
+    void drawPolygon(const QPointF*, int, PolygonDrawMode) override { ++calls; ++primitives; }
+    void drawPolygon(const QPoint*, int, PolygonDrawMode) override { ++calls; ++primitives; }
+    void drawTextItem(const QPointF&, const QTextItem&) override { ++calls; ++primitives; }
+    void drawPixmap(const QRectF&, const QPixmap&, const QRectF&) override { ++calls; ++primitives; }
+    void drawImage(const QRectF&, const QImage&, const QRectF&, Qt::ImageConversionFlags) override
+    {
+        ++calls;
+        ++primitives;
+    }
+    Type type() const override { return User; }
+};
+
+// Устройство размером с кадр, рисование на котором идет в CountingPaintEngine
+class CountingDevice : public QPaintDevice
+{
+public:
+    QPaintEngine* paintEngine() const override { return &m_engine; }
+    CountingPaintEngine& engine() { return m_engine; }
+
+protected:
+    int metric(PaintDeviceMetric metric) const override
+    {
+        switch (metric) {
+        case PdmWidth: return FrameSize.width();
+        case PdmHeight: return FrameSize.height();
+        case PdmWidthMM: return FrameSize.width() * 254 / 960;
+        case PdmHeightMM: return FrameSize.height() * 254 / 960;
+        case PdmNumColors: return INT_MAX;
+        case PdmDepth: return 32;
+        case PdmDpiX:
+        case PdmDpiY:
+        case PdmPhysicalDpiX:
+        case PdmPhysicalDpiY: return 96;
+        default: return QPaintDevice::metric(metric);
+        }
+    }
+
+private:
+    mutable CountingPaintEngine m_engine;
+};
+
+// Строка таблицы: вызовы движка за один кадр и среднее время кадра в QImage,
+// кадров - сколько уложится в SecondsPerCase, но не меньше одного
+template <typename Paint>
+void report(QTextStream& out, const QString& scene, Paint paint)
+{
+    CountingDevice device;
+    {
+        QPainter painter(&device);
+        painter.setRenderHint(QPainter::Antialiasing);
+        paint(painter);
+    }
+
+    QImage frame(FrameSize, QImage::Format_RGB32);
+    int frames = 0;
+    QElapsedTimer timer;
+    timer.start();
+    do {
+        frame.fill(Qt::white);
+        QPainter painter(&frame);
+        painter.setRenderHint(QPainter::Antialiasing);
+        paint(painter);
+        ++frames;
+    } while (timer.nsecsElapsed() < qint64(SecondsPerCase * 1e9));
+
+    const CountingPaintEngine& engine = device.engine();
+    out << QString("%1 %2 %3 %4 %5\n").arg(scene, -18).arg(engine.calls, 8).arg(engine.primitives, 10)
+               .arg(engine.penChanges, 6).arg(timer.nsecsElapsed() / 1e6 / frames, 10, 'f', 2);
+    out.flush();
+}
+
+// Правильный многоугольник во весь кадр, каждая 10-я стена - сферическое зеркало,
+// вогнутые и выпуклые через одно
+QVector<Wall*> createRoom(int count)
+{
+    QPointF center(FrameSize.width() / 2.0, FrameSize.height() / 2.0);
+    QVector<Wall*> walls = RoomBuilder::createWalls(RoomBuilder::regularPolygon(count, center, 280.0));
+    for (int i = 5, n = 0; i < walls.size(); i += 10, ++n) {
+        walls[i]->setMirrorType(Wall::Spherical);
+        walls[i]->setSphericalType(n % 2 ? Wall::Convex : Wall::Concave);
+        walls[i]->setRadius(2 * walls[i]->length());
+    }
+    return walls;
+}
+
+// Предпросмотр в настоящем окне: мышь выбирает угол, кадр рисуется обычной очередью событий.
+// Задержку от движения мыши до конца перерисовки меряет сам MirrorRoom (previewFrameMeasured)
+void reportPreview(QTextStream& out, int count)
+{
+    QPointF center(FrameSize.width() / 2.0, FrameSize.height() / 2.0);
+    MirrorRoom room;
+    room.resize(FrameSize);
+    room.show();
+    room.setRoomVertices(RoomBuilder::regularPolygon(count, center, 280.0));
+    QCoreApplication::processEvents();
+
+    int frames = 0;
+    double total = 0.0, worst = 0.0;
+    QObject::connect(&room, &MirrorRoom::previewFrameMeasured, [&](double milliseconds, double maxMilliseconds) {
+        ++frames;
+        total += milliseconds;
+        worst = maxMilliseconds;
+    });
+
+    // Точка старта - середина первой стены, дальше мышь обходит круг внутри комнаты
+    room.setSelectingStartPoint(true);
+    QPointF start = room.getWall(0)->pointAt(0.5);
+    QMouseEvent press(QEvent::MouseButtonPress, start, Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+    QCoreApplication::sendEvent(&room, &press);
+    QCoreApplication::processEvents();
+
+    for (int i = 0; i < PreviewMoves; ++i) {
+        double angle = 2 * M_PI * i / PreviewMoves;
+        QPointF position = center + 150 * QPointF(cos(angle), sin(angle));
+        QMouseEvent move(QEvent::MouseMove, position, Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+        QCoreApplication::sendEvent(&room, &move);
+        QCoreApplication::processEvents();
+    }
+
+    out << QString("%1 %2 %3 %4\n").arg(QString("walls %1").arg(count), -18).arg(frames, 8)
+               .arg(frames ? total / frames : 0.0, 10, 'f', 2).arg(worst, 10, 'f', 2);
+    out.flush();
+}
+
+}
+
+void runPaintBenchmark(QTextStream& out)
+{
+    RoomRenderer renderer;
+
+    out << QString("Paint, %1x%2 frame, antialiased (regular polygon rooms, every 10th wall curved)\n")
+               .arg(FrameSize.width()).arg(FrameSize.height());
+    out << QString("%1 %2 %3 %4 %5\n").arg("scene", -18).arg("calls", 8).arg("primitives", 10)
+               .arg("pens", 6).arg("ms/frame", 10);
+
+    // Стены: так строится картинка стен в MirrorRoom
+    for (int count : {4, 100, 1000}) {
+        QVector<Wall*> walls = createRoom(count);
+        report(out, QString("walls %1").arg(count), [&](QPainter& painter) {
+            renderer.drawWalls(painter, walls);
+        });
+        qDeleteAll(walls);
+    }
+
+    // Путь целиком, с нуля: так картинка луча строится после смены луча или размера окна.
+    // Обычный кадр дорисовывает только новые хвосты
+    QVector<Wall*> walls = createRoom(100);
+    WallTable table;
+    table.build(walls);
+    QPointF start = (table.startPoint(0) + table.endPoint(0)) / 2;
+    double angle = atan2(-table.normal(0).y(), -table.normal(0).x()) + 0.3;
+    QImage wallLayer(FrameSize, QImage::Format_RGB32);
+    QImage rayLayer(FrameSize, QImage::Format_ARGB32_Premultiplied);
+
+    for (int reflections : {1000, 100000, 1000000}) {
+        LightRay ray(start, angle, table, nullptr, reflections);
+        ray.path();
+        report(out, QString("ray %1").arg(reflections), [&](QPainter& painter) {
+            RoomRenderer::RayLod lod;
+            renderer.drawRay(painter, ray, QRectF(QPointF(0, 0), QSizeF(FrameSize)), lod);
+        });
+    }
+
+    // Кадр MirrorRoom с готовыми картинками стен и луча: два копирования
+    wallLayer.fill(Qt::white);
+    rayLayer.fill(Qt::transparent);
+    report(out, "frame (layers)", [&](QPainter& painter) {
+        painter.drawImage(0, 0, wallLayer);
+        painter.drawImage(0, 0, rayLayer);
+    });
+
+    qDeleteAll(walls);
+
+    out << QString("\nLive preview, mouse move to end of repaint (MirrorRoom, %1 moves, Grid)\n").arg(PreviewMoves);
+    out << QString("%1 %2 %3 %4\n").arg("room", -18).arg("frames", 8).arg("avg ms", 10).arg("max ms", 10);
+    for (int count : {100, 1000}) {
+        reportPreview(out, count);
+    }
+}
@@ -0,0 +1,10 @@
+#ifndef PAINTBENCHMARK_H
+#define PAINTBENCHMARK_H
+
+#include <QTextStream>
+
+// Замеры отрисовки для modelation_of_mirrors --paint-benchmark:
+// сколько вызовов получает движок QPainter и сколько длится кадр
+void runPaintBenchmark(QTextStream& out);
+
+#endif // PAINTBENCHMARK_H
@@ -0,0 +1,246 @@
+#include "roomrenderer.h"
+#include <QtMath>
+#include <cmath>
+
+namespace {
+
+// Пиксель точки одним числом: столбец в старших 32 битах, строка - в младших
+quint64 pixelKey(const QPointF& point, double pixel)
+{
+    return (quint64(quint32(qint32(qFloor(point.x() / pixel)))) << 32)
+           | quint32(qint32(qFloor(point.y() / pixel)));
+}
+
+}
+
+void RoomRenderer::drawWalls(QPainter& painter, const QVector<Wall*>& walls) const
+{
+    painter.save();
+
+    for (int group = 0; group < WallGroupCount; ++group) {
+        m_wallLines[group].clear();
+        m_wallArcs[group].clear();
+    }
+    m_indicatorLines.clear();
+
+    for (const Wall* wall : walls) {
+        WallGroup group = wallGroup(*wall);
+        QLineF line = wall->line();
+        if (wall->isArc()) {
+            // Дуга, по которой идет трассировка: углы в градусах,
+            // отсчет против часовой стрелки, как у QLineF::angle()
+            QPointF curvatureCenter = wall->curvatureCenter();
+            double radius = wall->curvatureRadius();
+            double startAngle = QLineF(curvatureCenter, line.p1()).angle();
+            double halfSpan = QLineF(curvatureCenter, wall->arcMiddle()).angle() - startAngle;
+            if (halfSpan > 180) halfSpan -= 360;
+            if (halfSpan <= -180) halfSpan += 360;
+
+            QRectF circle(curvatureCenter - QPointF(radius, radius), curvatureCenter + QPointF(radius, radius));
+            m_wallArcs[group].arcMoveTo(circle, startAngle);
+            m_wallArcs[group].arcTo(circle, startAngle, 2 * halfSpan);
+        } else {
+            m_wallLines[group].append(line);
+        }
+
+        if (wall->mirrorType() == Wall::Spherical) {
+            appendSphericalIndicator(*wall);
+        }
+    }
+
+    // Еще толще для легкого выбора
+    painter.setBrush(Qt::NoBrush);
+    for (int group = 0; group < WallGroupCount; ++group) {
+        if (m_wallLines[group].isEmpty() && m_wallArcs[group].isEmpty()) continue;
+        painter.setPen(QPen(groupColor(WallGroup(group)), 8));
+        if (!m_wallLines[group].isEmpty()) {
+            painter.drawLines(m_wallLines[group].constData(), m_wallLines[group].size());
+        }
+        if (!m_wallArcs[group].isEmpty()) {
+            painter.drawPath(m_wallArcs[group]);
+        }
+    }
+
+    if (!m_indicatorLines.isEmpty()) {
+        painter.setPen(QPen(Qt::white, 3));
+        painter.drawLines(m_indicatorLines.constData(), m_indicatorLines.size());
+    }
+
+    // Draw wall info
+    painter.setPen(Qt::black);
+    painter.setFont(QFont("Arial", 10, QFont::Bold));
+    for (const Wall* wall : walls) {
+        QLineF line = wall->line();
+        QPointF textPos = (line.p1() + line.p2()) / 2 + QPointF(0, -20);
+        QString info = wall->getTypeString();
+        if (wall->mirrorType() == Wall::Spherical) {
+            info += QString(" R=%1").arg((int)wall->radius());
+        }
+        painter.drawText(textPos, info);
+    }
+
+    painter.restore();
+}
+
+void RoomRenderer::appendSphericalIndicator(const Wall& wall) const
+{
+    // Стрелка от середины стены: у вогнутого зеркала - внутрь, у выпуклого - наружу
+    QLineF line = wall.line();
+    QPointF center = wall.isArc() ? wall.arcMiddle() : (line.p1() + line.p2()) / 2;
+
+    // Нормаль длиной 30, центрированная на середине стены
+    QLineF normal = line.normalVector();
+    normal.setLength(30);
+    normal.translate(center - normal.p1());
+    QPointF tip = wall.sphericalType() == Wall::Concave ? normal.p2() : 2 * center - normal.p2();
+    m_indicatorLines.append(QLineF(center, tip));
+
+    // Стрелка
+    QLineF arrowLine(center, tip);
+    arrowLine.setLength(25);
+    QPointF arrowEnd = arrowLine.p2();
+
+    // Перпендикуляры для стрелки
+    QLineF perpendicular = arrowLine.normalVector();
+    perpendicular.setLength(8);
+    perpendicular.translate(arrowEnd - perpendicular.p1());
+
+    m_indicatorLines.append(QLineF(arrowEnd, perpendicular.p1()));
+    m_indicatorLines.append(QLineF(arrowEnd, perpendicular.p2()));
+}
+
+QRectF RoomRenderer::drawRay(QPainter& painter, const LightRay& ray, const QRectF& exposed, RayLod& lod,
+                             int maxPoints) const
+{
+    const QVector<QPointF>& path = ray.tracedPath();
+    int count = path.size();
+    // Путь стал короче - его обрезали, а не досчитали: рисуется заново
+    if (lod.drawn > count) {
+        lod = RayLod();
+    }
+    if (lod.drawn == count) return QRectF();
+    int end = count - lod.drawn > maxPoints ? lod.drawn + maxPoints : count;
+
+    // Пиксель в координатах виджета, с учетом DPR и масштаба painter
+    double scale = std::sqrt(std::abs(painter.deviceTransform().determinant()));
+    double pixel = scale > 0 ? 1.0 / scale : 1.0;
+
+    QRect cells(QPoint(qFloor(exposed.left() / ArrowSpacing), qFloor(exposed.top() / ArrowSpacing)),
+                QPoint(qFloor(exposed.right() / ArrowSpacing), qFloor(exposed.bottom() / ArrowSpacing)));
+    if (lod.cells != cells) {
+        lod.cells = cells;
+        lod.arrows = QVector<bool>(cells.width() * cells.height(), false);
+    }
+    if (lod.drawn == 0) {
+        lod.lastPoint = path[0];
+        lod.drawn = 1;
+    }
+
+    // Отрезки вне открытой области пропускаются целиком; запас - перо и указатели направления
+    const double margin = 12;
+    m_segments.clear();
+    m_arrowLines.clear();
+    double left = 0, top = 0, right = 0, bottom = 0;
+
+    for (int i = lod.drawn; i < end; ++i) {
+        const QPointF& point = path[i];
+        // Вершина в пределах пикселя от нарисованной сливается с ней
+        QPointF delta = point - lod.lastPoint;
+        if (std::abs(delta.x()) < pixel && std::abs(delta.y()) < pixel) continue;
+
+        QPointF from = lod.lastPoint;
+        lod.lastPoint = point;
+        if (!QRectF(from, point).normalized().adjusted(-margin, -margin, margin, margin).intersects(exposed)) continue;
+
+        // Отрезок между теми же пикселями уже нарисован - в ту или другую сторону
+        quint64 fromKey = pixelKey(from, pixel);
+        quint64 toKey = pixelKey(point, pixel);
+        QPair<quint64, quint64> segmentKey = fromKey < toKey ? qMakePair(fromKey, toKey) : qMakePair(toKey, fromKey);
+        if (lod.segments.contains(segmentKey)) continue;
+        lod.segments.insert(segmentKey);
+
+        if (m_segments.isEmpty()) {
+            left = right = from.x();
+            top = bottom = from.y();
+        }
+        m_segments.append(QLineF(from, point));
+        left = qMin(left, qMin(from.x(), point.x()));
+        right = qMax(right, qMax(from.x(), point.x()));
+        top = qMin(top, qMin(from.y(), point.y()));
+        bottom = qMax(bottom, qMax(from.y(), point.y()));
+
+        // Стрелка - только в клетке, где ее еще нет
+        QPoint cell(qFloor(point.x() / ArrowSpacing), qFloor(point.y() / ArrowSpacing));
+        if (!cells.contains(cell)) continue;
+        int slot = (cell.y() - cells.top()) * cells.width() + (cell.x() - cells.left());
+        if (lod.arrows[slot]) continue;
+        lod.arrows[slot] = true;
+        appendArrow(QLineF(from, point));
+    }
+    lod.drawn = end;
+
+    // Весь путь - одним вызовом, стрелки поверх - другим
+    if (m_segments.isEmpty()) return QRectF();
+    painter.setPen(QPen(Qt::yellow, 2));
+    painter.drawLines(m_segments.constData(), m_segments.size());
+    if (!m_arrowLines.isEmpty()) {
+        painter.setPen(QPen(Qt::red, 1));
+        painter.drawLines(m_arrowLines.constData(), m_arrowLines.size());
+    }
+    // Стрелки не дальше 10 от концов отрезка: хватает того же запаса, что и у отсечения
+    return QRectF(QPointF(left, top), QPointF(right, bottom)).adjusted(-margin, -margin, margin, margin);
+}
+
+void RoomRenderer::appendArrow(const QLineF& segment) const
+{
+    // Draw ray direction indicators
+    QLineF unit = segment.unitVector();
+    unit.setLength(10);
+    QPointF arrowP1 = unit.p2();
+    unit.setAngle(unit.angle() + 30);
+    QPointF arrowP2 = unit.p2();
+    unit.setAngle(unit.angle() - 60);
+    QPointF arrowP3 = unit.p2();
+
+    m_arrowLines.append(QLineF(segment.p2(), arrowP1));
+    m_arrowLines.append(QLineF(segment.p2(), arrowP2));
+    m_arrowLines.append(QLineF(segment.p2(), arrowP3));
+}
+
+void RoomRenderer::drawPreview(QPainter& painter, const LightRay& ray, const QRectF& exposed) const
+{
+    const QVector<QPointF>& path = ray.tracedPath();
+    int count = path.size();
+    if (count < 2) return;
+
+    const double margin = 2;
+    m_segments.clear();
+    for (int i = 1; i < count; ++i) {
+        if (!QRectF(path[i-1], path[i]).normalized().adjusted(-margin, -margin, margin, margin).intersects(exposed)) continue;
+        m_segments.append(QLineF(path[i-1], path[i]));
+    }
+    if (!m_segments.isEmpty()) {
+        painter.setPen(QPen(QColor(255, 140, 0, 160), 1));
+        painter.drawLines(m_segments.constData(), m_segments.size());
+    }
+}
+
+RoomRenderer::WallGroup RoomRenderer::wallGroup(const Wall& wall) const
+{
+    if (wall.mirrorType() != Wall::Spherical) return FlatGroup;
+    return wall.sphericalType() == Wall::Concave ? ConcaveGroup : ConvexGroup;
+}
+
+QColor RoomRenderer::groupColor(WallGroup group) const
+{
+    switch (group) {
+    case FlatGroup:
+        return QColor(0, 100, 200); // Blue for flat mirrors
+    case ConcaveGroup:
+        return QColor(200, 0, 0); // Red
+    case ConvexGroup:
+        return QColor(0, 150, 0); // Green
+    default:
+        return Qt::black;
+    }
+}
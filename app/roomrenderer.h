@@ -0,0 +1,64 @@
+#ifndef ROOMRENDERER_H
+#define ROOMRENDERER_H
+
+#include <QPainter>
+#include <QPainterPath>
+#include <QPair>
+#include <QSet>
+#include <limits>
+#include "wall.h"
+#include "lightray.h"
+
+// Отрисовка объектов ядра трассировки.
+// Wall и LightRay живут в библиотеке без QtGui, поэтому рисование вынесено сюда.
+class RoomRenderer
+{
+public:
+    // Стены рисуются группами по перу: отрезки и дуги одного цвета - одним вызовом,
+    // указатели сферических зеркал - одним, подписи - с одной сменой пера и шрифта
+    void drawWalls(QPainter& painter, const QVector<Wall*>& walls) const;
+
+    // Состояние упрощенного рисования пути: докуда путь пройден и где уже стоят стрелки.
+    // С ним drawRay() дорисовывает только отрезки, досчитанные после прошлого вызова
+    struct RayLod
+    {
+        int drawn = 0;              // пройдено точек пути
+        QPointF lastPoint;          // последняя нарисованная вершина
+        QRect cells;                // сетка под стрелки, в клетках ArrowSpacing
+        QVector<bool> arrows;       // клетки, где стрелка уже есть
+        QSet<QPair<quint64, quint64>> segments;  // нарисованные отрезки по пикселям концов
+    };
+    // Стрелки направления - не чаще одной на клетку ArrowSpacing x ArrowSpacing экрана
+    static const int ArrowSpacing = 40;
+
+    // Уже посчитанная часть пути (LightRay::tracedPath()); рисование трассировку не запускает.
+    // Вершины ближе пикселя к предыдущей сливаются, отрезки вне exposed пропускаются,
+    // отрезок между теми же пикселями, что и нарисованный, не рисуется повторно. Поэтому
+    // периодичный путь стоит столько, сколько у него разных отрезков; хаотичный почти
+    // не повторяется, и его рисование остается линейным по длине пути. За вызов
+    // проходится не больше maxPoints точек; остаток дорисует следующий вызов. Возвращает
+    // охват нарисованного вместе с пером и стрелками (пустой, если ничего не нарисовано) -
+    // его и нужно перерисовать
+    QRectF drawRay(QPainter& painter, const LightRay& ray, const QRectF& exposed, RayLod& lod,
+                   int maxPoints = std::numeric_limits<int>::max()) const;
+    // Предпросмотр при выборе угла: тонкая линия без указателей направления, чтобы кадр
+    // оставался дешевым и не заслонял уже запущенный луч
+    void drawPreview(QPainter& painter, const LightRay& ray, const QRectF& exposed) const;
+
+private:
+    // Группы стен с одним пером: плоские, вогнутые, выпуклые
+    enum WallGroup { FlatGroup, ConcaveGroup, ConvexGroup, WallGroupCount };
+    WallGroup wallGroup(const Wall& wall) const;
+    QColor groupColor(WallGroup group) const;
+    void appendSphericalIndicator(const Wall& wall) const;
+    void appendArrow(const QLineF& segment) const;
+
+    // Буферы примитивов живут между кадрами: clear() сохраняет память, и кадр не выделяет ее заново
+    mutable QVector<QLineF> m_wallLines[WallGroupCount];
+    mutable QPainterPath m_wallArcs[WallGroupCount];
+    mutable QVector<QLineF> m_indicatorLines;
+    mutable QVector<QLineF> m_segments;
+    mutable QVector<QLineF> m_arrowLines;
+};
+
+#endif // ROOMRENDERER_H
@@ -0,0 +1,127 @@
+#include "traceworker.h"
+
+namespace {
+
+// Первый кусок маленький, чтобы первые отражения появились сразу; дальше куски растут
+// вчетверо, но не больше MaxChunkReflections, чтобы отмена срабатывала за миллисекунды
+const int FirstChunkReflections = 2000;
+const int MaxChunkReflections = 1 << 16;
+
+}
+
+TraceRoom::TraceRoom(const QVector<Wall*>& walls, WallIndex::Backend backend)
+    : index(nullptr)
+    , backend(backend)
+{
+    table.build(walls);
+    index = WallIndex::create(backend);
+    if (index) {
+        index->build(table);
+    }
+}
+
+TraceRoom::~TraceRoom()
+{
+    delete index;
+}
+
+TraceWorker::TraceWorker(QObject* parent)
+    : QObject(parent)
+    , m_generation(0)
+    , m_ray(nullptr)
+    , m_quit(false)
+{
+    m_thread = QThread::create([this] { run(); });
+    m_thread->start();
+}
+
+TraceWorker::~TraceWorker()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_quit = true;
+        ++m_generation;
+        m_wake.wakeAll();
+    }
+    m_thread->wait();
+    delete m_thread;
+    delete m_ray;
+}
+
+void TraceWorker::start(const LightRay& ray, const QSharedPointer<const TraceRoom>& room)
+{
+    QMutexLocker locker(&m_mutex);
+    ++m_generation;
+    delete m_ray;
+    m_ray = new LightRay(ray);
+    m_room = room;
+    m_tails.clear();
+    m_wake.wakeAll();
+}
+
+void TraceWorker::cancel()
+{
+    QMutexLocker locker(&m_mutex);
+    ++m_generation;
+    delete m_ray;
+    m_ray = nullptr;
+    m_room.clear();
+    m_tails.clear();
+}
+
+QVector<LightRay::Tail> TraceWorker::takeTails()
+{
+    QMutexLocker locker(&m_mutex);
+    QVector<LightRay::Tail> tails;
+    tails.swap(m_tails);
+    return tails;
+}
+
+bool TraceWorker::current(quint64 generation)
+{
+    QMutexLocker locker(&m_mutex);
+    return generation == m_generation;
+}
+
+void TraceWorker::run()
+{
+    while (true) {
+        // Ждем запрос; ссылка на комнату держит ее таблицу и индекс, пока GUI может прислать следующий
+        LightRay* ray;
+        QSharedPointer<const TraceRoom> room;
+        quint64 generation;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (!m_ray && !m_quit) {
+                m_wake.wait(&m_mutex);
+            }
+            if (m_quit) return;
+
+            ray = m_ray;
+            m_ray = nullptr;
+            room.swap(m_room);
+            generation = m_generation;
+        }
+
+        // Индекс строит GUI один раз на ревизию комнаты; здесь он только читается
+        ray->setWallTable(room->table);
+        ray->setWallIndex(room->index);
+
+        int chunk = FirstChunkReflections;
+        while (!ray->complete() && current(generation)) {
+            int from = ray->reflections();
+            ray->path(from + chunk);
+            chunk = qMin(chunk * 4, MaxChunkReflections);
+
+            {
+                QMutexLocker locker(&m_mutex);
+                if (generation != m_generation) break;
+                m_tails.append(ray->tail(from));
+            }
+            // Сигнал из чужого потока доходит до получателя через его очередь событий
+            emit rayTraced();
+        }
+
+        delete ray;
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef TRACEWORKER_H
+#define TRACEWORKER_H
+
+#include <QMutex>
+#include <QObject>
+#include <QSharedPointer>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+#include "lightray.h"
+#include "walltable.h"
+#include "wallindex.h"
+
+// Таблица стен одной ревизии комнаты и ускоряющая структура над ней. После постройки
+// только читаются, поэтому один экземпляр разделяют лучи GUI и потоки трассировки;
+// поток держит ссылку, пока считает, и перестройка комнаты в GUI его не задевает
+struct TraceRoom
+{
+    TraceRoom(const QVector<Wall*>& walls, WallIndex::Backend backend);
+    ~TraceRoom();
+
+    WallTable table;
+    WallIndex* index;           // nullptr для LinearScan
+    WallIndex::Backend backend;
+
+private:
+    Q_DISABLE_COPY(TraceRoom)
+};
+
+// Трассировка луча в отдельном потоке, чтобы поток GUI не ждал ее ни при каком числе отражений.
+// start() отдает потоку копию луча (с уже посчитанной частью пути) и комнату TraceRoom;
+// поток досчитывает путь кусками и после каждого куска выкладывает хвост
+// (LightRay::Tail) и посылает rayTraced(). Новый start() или cancel() отменяет
+// текущий запрос: поток бросает его на границе куска, хвосты отмененного не приходят
+class TraceWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TraceWorker(QObject* parent = nullptr);
+    ~TraceWorker() override;
+
+    // Досчитывает путь копии ray до ее предела в комнате room - той же, что у ray в GUI
+    void start(const LightRay& ray, const QSharedPointer<const TraceRoom>& room);
+    void cancel();
+
+    // Хвосты текущего запроса в порядке подсчета; каждый продолжает предыдущий
+    QVector<LightRay::Tail> takeTails();
+
+signals:
+    // Готов новый хвост; приходит в поток получателя через очередь событий
+    void rayTraced();
+
+private:
+    QThread* m_thread;
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    // Все ниже - под m_mutex
+    quint64 m_generation;       // номер текущего запроса; отмена увеличивает его
+    LightRay* m_ray;            // запрос, еще не взятый потоком
+    QSharedPointer<const TraceRoom> m_room;
+    QVector<LightRay::Tail> m_tails;
+    bool m_quit;
+
+    void run();
+    bool current(quint64 generation);
+};
+
+#endif // TRACEWORKER_H
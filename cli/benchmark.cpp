@@ -0,0 +1,333 @@
+#include "benchmark.h"
+#include <QElapsedTimer>
+#include <QThread>
+#include "anglesweep.h"
+#include "basictracer.h"
+#include "lightray.h"
+#include "packettracer.h"
+#include "roombuilder.h"
+#include "walltable.h"
+#include "wallindex.h"
+
+namespace {
+
+const double SecondsPerCase = 0.5;
+const int ReflectionsPerRay = 200;
+
+// Отражений в секунду: трассируем лучи из середины стены 0 под разными углами,
+// пока не наберется SecondsPerCase
+double bouncesPerSecond(const WallTable& table, const WallIndex* index)
+{
+    QPointF start = (table.startPoint(0) + table.endPoint(0)) / 2;
+    double baseAngle = atan2(-table.normal(0).y(), -table.normal(0).x());
+
+    qint64 bounces = 0;
+    int rayIndex = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    do {
+        double angle = baseAngle + 0.9 * sin(0.7 * rayIndex++);
+        LightRay ray(start, angle, table, index, ReflectionsPerRay);
+        bounces += ray.path().size() - 1;
+    } while (timer.nsecsElapsed() < qint64(SecondsPerCase * 1e9));
+
+    return bounces / (timer.nsecsElapsed() / 1e9);
+}
+
+// То же для трассировки в точности Real линейным проходом
+template <typename Real>
+double tracerBouncesPerSecond(const WallTable& table)
+{
+    BasicTracer<Real> tracer(table);
+    QPointF start = (table.startPoint(0) + table.endPoint(0)) / 2;
+    double baseAngle = atan2(-table.normal(0).y(), -table.normal(0).x());
+
+    qint64 bounces = 0;
+    int rayIndex = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    do {
+        double angle = baseAngle + 0.9 * sin(0.7 * rayIndex++);
+        bounces += tracer.trace(start, angle, ReflectionsPerRay).size() - 1;
+    } while (timer.nsecsElapsed() < qint64(SecondsPerCase * 1e9));
+
+    return bounces / (timer.nsecsElapsed() / 1e9);
+}
+
+// Веер из FanSize лучей из середины стены 0 с шагом FanStep радиан
+const int FanSize = 256;
+const double FanStep = 1e-4;
+
+QVector<double> fanAngles(const WallTable& table)
+{
+    double baseAngle = atan2(-table.normal(0).y(), -table.normal(0).x()) + 0.3;
+    QVector<double> angles;
+    for (int i = 0; i < FanSize; ++i) {
+        angles.append(baseAngle + (i - FanSize / 2) * FanStep);
+    }
+    return angles;
+}
+
+// Лучей веера в секунду: каждый луч отдельным LightRay или весь веер пакетами
+double fanRaysPerSecond(const WallTable& table, const WallIndex* index, int reflections, bool packets)
+{
+    QPointF start = (table.startPoint(0) + table.endPoint(0)) / 2;
+    QVector<double> angles = fanAngles(table);
+    PacketTracer tracer(table, index);
+
+    qint64 rays = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    do {
+        if (packets) {
+            tracer.traceFan(start, angles, reflections);
+        } else {
+            // Путь LightRay ленивый: без path() луч не трассировался бы вовсе
+            for (double angle : angles) {
+                LightRay ray(start, angle, table, index, reflections);
+                ray.path();
+            }
+        }
+        rays += angles.size();
+    } while (timer.nsecsElapsed() < qint64(SecondsPerCase * 1e9));
+
+    return rays / (timer.nsecsElapsed() / 1e9);
+}
+
+// Правильный 16-угольник, у которого одна стена в углу заменена
+// мелкой "пилой" из оставшихся стен - имитация детализированного угла нарисованной комнаты
+QVector<QPointF> clusteredRoom(int count, double radius)
+{
+    QVector<QPointF> outline = RoomBuilder::regularPolygon(16, QPointF(0, 0), radius);
+    int teeth = qMax(0, count - outline.size());
+
+    QPointF from = outline[1];
+    QPointF to = outline[1] + (outline[2] - outline[1]) * 0.05;
+    QLineF base(from, to);
+    QPointF inward = base.normalVector().unitVector().p2() - from;
+
+    QVector<QPointF> vertices = outline.mid(0, 2);
+    for (int i = 1; i < teeth; ++i) {
+        double offset = (i % 2) ? 0.02 * base.length() : 0.0;
+        vertices.append(base.pointAt(double(i) / teeth) + inward * offset);
+    }
+    vertices.append(outline.mid(2));
+    return vertices;
+}
+
+}
+
+void runIndexBenchmark(QTextStream& out)
+{
+    const WallIndex::Backend backends[] = {WallIndex::LinearScan, WallIndex::UniformGrid, WallIndex::Bvh};
+
+    for (bool clustered : {false, true}) {
+        out << (clustered ? "\nClustered rooms (fine detail in one corner)\n"
+                          : "Regular polygon rooms\n");
+        out << QString("%1 %2 %3 %4\n")
+                   .arg("walls", 8).arg("linear b/s", 14).arg("grid b/s", 14).arg("bvh b/s", 14);
+
+        for (int count : {10, 1000, 100000}) {
+            QVector<QPointF> vertices = clustered ? clusteredRoom(count, 2000.0)
+                                                  : RoomBuilder::regularPolygon(count, QPointF(0, 0), 2000.0);
+            QVector<Wall*> walls = RoomBuilder::createWalls(vertices);
+            WallTable table;
+            table.build(walls);
+
+            out << QString("%1").arg(walls.size(), 8);
+            for (WallIndex::Backend backend : backends) {
+                WallIndex* index = WallIndex::create(backend);
+                if (index) {
+                    index->build(table);
+                }
+                out << QString(" %1").arg(bouncesPerSecond(table, index), 14, 'f', 0);
+                out.flush();
+                delete index;
+            }
+            out << "\n";
+
+            qDeleteAll(walls);
+        }
+    }
+
+    // Линейный проход разными ядрами: сколько дает SIMD без ускоряющих структур
+    const WallKernel::Kind kernels[] = {WallKernel::Scalar, WallKernel::Sse2, WallKernel::Avx2, WallKernel::Avx512};
+
+    out << "\nLinear scan kernels (regular polygon rooms)\n";
+    out << QString("%1").arg("walls", 8);
+    for (WallKernel::Kind kind : kernels) {
+        out << QString(" %1").arg(WallKernel::name(kind) + " b/s", 14);
+    }
+    out << "\n";
+
+    for (int count : {10, 1000, 100000}) {
+        QVector<Wall*> walls = RoomBuilder::createWalls(RoomBuilder::regularPolygon(count, QPointF(0, 0), 2000.0));
+        WallTable table;
+        table.build(walls);
+
+        out << QString("%1").arg(walls.size(), 8);
+        for (WallKernel::Kind kind : kernels) {
+            if (WallKernel::isSupported(kind)) {
+                table.setKernel(kind);
+                out << QString(" %1").arg(bouncesPerSecond(table, nullptr), 14, 'f', 0);
+            } else {
+                out << QString(" %1").arg("-", 14);
+            }
+            out.flush();
+        }
+        out << "\n";
+
+        qDeleteAll(walls);
+    }
+
+    // Точность трассировки: float вдвое расширяет векторное ядро, long double идет скалярно
+    out << QString("\nPrecision, linear scan with the %1 kernel (regular polygon rooms)\n")
+               .arg(WallKernel::name(WallKernel::best()));
+    out << QString("%1 %2 %3 %4\n").arg("walls", 8).arg("float b/s", 14).arg("double b/s", 14)
+               .arg("long-double b/s", 16);
+
+    for (int count : {10, 1000, 100000}) {
+        QVector<Wall*> walls = RoomBuilder::createWalls(RoomBuilder::regularPolygon(count, QPointF(0, 0), 2000.0));
+        WallTable table;
+        table.build(walls);
+
+        out << QString("%1").arg(walls.size(), 8);
+        out << QString(" %1").arg(tracerBouncesPerSecond<float>(table), 14, 'f', 0);
+        out.flush();
+        out << QString(" %1").arg(tracerBouncesPerSecond<double>(table), 14, 'f', 0);
+        out.flush();
+        out << QString(" %1\n").arg(tracerBouncesPerSecond<long double>(table), 16, 'f', 0);
+        out.flush();
+
+        qDeleteAll(walls);
+    }
+
+    // Типы зеркал: комната без дуг идет плоской веткой, дуги проверяются после ядра
+    out << "\nMirror types, linear scan (regular polygon rooms, every 10th wall curved)\n";
+    out << QString("%1 %2 %3 %4\n").arg("walls", 8).arg("flat b/s", 14).arg("concave b/s", 14)
+               .arg("convex b/s", 14);
+
+    for (int count : {10, 1000, 100000}) {
+        QVector<Wall*> walls = RoomBuilder::createWalls(RoomBuilder::regularPolygon(count, QPointF(0, 0), 2000.0));
+
+        out << QString("%1").arg(walls.size(), 8);
+        for (int type = 0; type < 3; ++type) {
+            for (int i = 5; i < walls.size(); i += 10) {
+                walls[i]->setMirrorType(type == 0 ? Wall::Flat : Wall::Spherical);
+                walls[i]->setSphericalType(type == 1 ? Wall::Concave : Wall::Convex);
+                walls[i]->setRadius(2 * walls[i]->length());
+            }
+            WallTable table;
+            table.build(walls);
+            out << QString(" %1").arg(bouncesPerSecond(table, nullptr), 14, 'f', 0);
+            out.flush();
+        }
+        out << "\n";
+
+        qDeleteAll(walls);
+    }
+
+    // Веер лучей: по одному и пакетами. Лучи веера идут рядом первые несколько отражений,
+    // поэтому выигрыш пакетов виден на коротких путях и размывается на длинных
+    out << QString("\nFan of %1 rays, %2 rad apart (regular polygon rooms)\n").arg(FanSize).arg(FanStep);
+    out << QString("%1 %2 %3 %4 %5 %6\n").arg("walls", 8).arg("accel", 8).arg("bounces", 8)
+               .arg("single rays/s", 14).arg("packet rays/s", 14).arg("speedup", 8);
+
+    for (int count : {10, 1000, 100000}) {
+        QVector<Wall*> walls = RoomBuilder::createWalls(RoomBuilder::regularPolygon(count, QPointF(0, 0), 2000.0));
+        WallTable table;
+        table.build(walls);
+
+        for (WallIndex::Backend backend : backends) {
+            // Линейный проход по 100000 стенам слишком долог для веера
+            if (backend == WallIndex::LinearScan && count > 1000) continue;
+
+            WallIndex* index = WallIndex::create(backend);
+            if (index) {
+                index->build(table);
+            }
+            for (int reflections : {8, ReflectionsPerRay}) {
+                double single = fanRaysPerSecond(table, index, reflections, false);
+                double packet = fanRaysPerSecond(table, index, reflections, true);
+                out << QString("%1 %2 %3 %4 %5 %6\n").arg(walls.size(), 8)
+                           .arg(WallIndex::backendName(backend), 8).arg(reflections, 8)
+                           .arg(single, 14, 'f', 0).arg(packet, 14, 'f', 0).arg(packet / single, 8, 'f', 2);
+                out.flush();
+            }
+            delete index;
+        }
+
+        qDeleteAll(walls);
+    }
+
+    // Развертка по углу на нескольких потоках: полукруг лучей из середины стены 0
+    out << "\nAngle sweep, 100000 rays over 180 degrees (1000-wall polygon, bvh)\n";
+    out << QString("%1 %2\n").arg("threads", 8).arg("rays/s", 14);
+    {
+        QVector<Wall*> walls = RoomBuilder::createWalls(RoomBuilder::regularPolygon(1000, QPointF(0, 0), 2000.0));
+        WallTable table;
+        table.build(walls);
+        WallIndex* index = WallIndex::create(WallIndex::Bvh);
+        index->build(table);
+
+        QPointF start = (table.startPoint(0) + table.endPoint(0)) / 2;
+        double inward = atan2(-table.normal(0).y(), -table.normal(0).x());
+        const int samples = 100000;
+
+        QVector<int> threadCounts = {1};
+        for (int threads = 2; threads < QThread::idealThreadCount(); threads *= 2) {
+            threadCounts.append(threads);
+        }
+        if (QThread::idealThreadCount() > 1) {
+            threadCounts.append(QThread::idealThreadCount());
+        }
+
+        for (int threads : threadCounts) {
+            AngleSweep sweep(table, index);
+            sweep.setThreadCount(threads);
+            QElapsedTimer timer;
+            timer.start();
+            sweep.run(start, inward - M_PI / 2, inward + M_PI / 2, samples, 50);
+            out << QString("%1 %2\n").arg(threads, 8).arg(samples / (timer.nsecsElapsed() / 1e9), 14, 'f', 0);
+            out.flush();
+        }
+
+        delete index;
+        qDeleteAll(walls);
+    }
+
+    // Предпросмотр в GUI: на каждое движение мыши новый луч линейным проходом
+    // с бюджетом PreviewBudget на первый кадр; задержка - от создания луча до конца бюджета
+    const double PreviewBudget = 4.0;
+    out << QString("\nLive preview, %1 ms trace budget per frame, 1000 cursor positions\n").arg(PreviewBudget);
+    out << QString("%1 %2 %3 %4\n").arg("walls", 8).arg("bounces", 10).arg("avg ms", 10).arg("max ms", 10);
+    for (int count : {1000, 10000}) {
+        QVector<Wall*> walls = RoomBuilder::createWalls(RoomBuilder::regularPolygon(count, QPointF(0, 0), 2000.0));
+        WallTable table;
+        table.build(walls);
+
+        QPointF start = (table.startPoint(0) + table.endPoint(0)) / 2;
+        double inward = atan2(-table.normal(0).y(), -table.normal(0).x());
+        const int positions = 1000;
+        qint64 bounces = 0;
+        qint64 totalNs = 0;
+        qint64 maxNs = 0;
+        for (int i = 0; i < positions; ++i) {
+            double angle = inward - M_PI / 2 + M_PI * (i + 0.5) / positions;
+            QElapsedTimer timer;
+            timer.start();
+            LightRay ray(start, angle, table, nullptr, 1000000);
+            bounces += ray.traceFor(qint64(PreviewBudget * 1e6));
+            qint64 elapsed = timer.nsecsElapsed();
+            totalNs += elapsed;
+            maxNs = qMax(maxNs, elapsed);
+        }
+        out << QString("%1 %2 %3 %4\n").arg(count, 8).arg(int(bounces / positions), 10)
+                   .arg(totalNs / 1e6 / positions, 10, 'f', 2).arg(maxNs / 1e6, 10, 'f', 2);
+        out.flush();
+        qDeleteAll(walls);
+    }
+}
@@ -0,0 +1,9 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QTextStream>
+
+// Замеры скорости трассировки для mirrortrace --benchmark
+void runIndexBenchmark(QTextStream& out);
+
+#endif // BENCHMARK_H
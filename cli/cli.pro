@@ -0,0 +1,22 @@
+QT = core
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = mirrortrace
+
+include(../core/core.pri)
+
+SOURCES += \
+    benchmark.cpp \
+    kernelcheck.cpp \
+    main.cpp
+
+HEADERS += \
+    benchmark.h \
+    kernelcheck.h
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
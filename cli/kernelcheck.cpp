@@ -0,0 +1,239 @@
+#include "kernelcheck.h"
+#include <QtMath>
+#include <random>
+#include "basictracer.h"
+#include "lightray.h"
+#include "packettracer.h"
+#include "roombuilder.h"
+#include "walltable.h"
+#include "wallindex.h"
+
+namespace {
+
+const int RoomCount = 200;
+const int QueriesPerRoom = 500;
+const int RaysPerRoom = 4;
+const int ReflectionsPerRay = 200;
+const int FanSize = 37; // не кратно размеру пакета, чтобы проверить неполные пакеты
+
+// Звездчатый многоугольник со случайными углами и радиусами вершин, внутри -
+// случайные перегородки и точные копии части стен, чтобы проверить выбор при равных расстояниях.
+// В половине комнат часть стен - вогнутые и выпуклые дуги
+QVector<Wall*> randomRoom(std::mt19937& random)
+{
+    std::uniform_int_distribution<int> countDistribution(3, 400);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    int count = countDistribution(random);
+    QVector<double> angles;
+    for (int i = 0; i < count; ++i) {
+        angles.append(unit(random) * 2 * M_PI);
+    }
+    std::sort(angles.begin(), angles.end());
+
+    QVector<QPointF> vertices;
+    for (double angle : angles) {
+        double radius = 500.0 * (0.3 + 0.7 * unit(random));
+        vertices.append(QPointF(radius * cos(angle), radius * sin(angle)));
+    }
+
+    QVector<Wall*> walls = RoomBuilder::createWalls(vertices);
+
+    int extra = std::uniform_int_distribution<int>(0, count / 4)(random);
+    for (int i = 0; i < extra; ++i) {
+        if (unit(random) < 0.5) {
+            const Wall* copy = walls[std::uniform_int_distribution<int>(0, walls.size() - 1)(random)];
+            walls.append(new Wall(copy->startPoint(), copy->endPoint()));
+        } else {
+            QPointF a(300.0 * (2 * unit(random) - 1), 300.0 * (2 * unit(random) - 1));
+            QPointF b(300.0 * (2 * unit(random) - 1), 300.0 * (2 * unit(random) - 1));
+            walls.append(new Wall(a, b));
+        }
+    }
+
+    if (unit(random) < 0.5) {
+        for (Wall* wall : walls) {
+            if (unit(random) < 0.7) continue;
+            wall->setMirrorType(Wall::Spherical);
+            wall->setSphericalType(unit(random) < 0.5 ? Wall::Concave : Wall::Convex);
+            wall->setRadius(wall->length() * (0.4 + 3.0 * unit(random)));
+        }
+    }
+
+    return walls;
+}
+
+// QPointF::operator== сравнивает нечетко, здесь нужно побитовое совпадение
+bool samePath(const QVector<QPointF>& a, const QVector<QPointF>& b)
+{
+    if (a.size() != b.size()) return false;
+    for (int i = 0; i < a.size(); ++i) {
+        if (a[i].x() != b[i].x() || a[i].y() != b[i].y()) return false;
+    }
+    return true;
+}
+
+}
+
+bool runKernelCheck(QTextStream& out)
+{
+    const WallKernel::Kind kinds[] = {WallKernel::Sse2, WallKernel::Avx2, WallKernel::Avx512};
+
+    std::mt19937 random(20240607);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    int mismatches[4] = {0, 0, 0, 0};
+    const WallIndex::Backend backends[] = {WallIndex::UniformGrid, WallIndex::Bvh};
+    int indexMismatches[2] = {0, 0};
+    int packetMismatches = 0;
+    int precisionMismatches = 0;
+    int queries = 0;
+    int rays = 0;
+    int fans = 0;
+
+    for (int room = 0; room < RoomCount; ++room) {
+        QVector<Wall*> walls = randomRoom(random);
+
+        WallTable reference;
+        reference.setKernel(WallKernel::Scalar);
+        reference.build(walls);
+
+        WallTable tables[3];
+        for (int k = 0; k < 3; ++k) {
+            tables[k].setKernel(kinds[k]);
+            tables[k].build(walls);
+        }
+
+        WallIndex* indexes[2];
+        for (int b = 0; b < 2; ++b) {
+            indexes[b] = WallIndex::create(backends[b]);
+            indexes[b]->build(reference);
+        }
+
+        // Отдельные запросы: случайная точка, направление и отрезок луча
+        for (int q = 0; q < QueriesPerRoom; ++q) {
+            QPointF origin(600.0 * (2 * unit(random) - 1), 600.0 * (2 * unit(random) - 1));
+            double angle = unit(random) * 2 * M_PI;
+            QPointF direction(cos(angle), sin(angle));
+            double minDistance = unit(random) < 0.5 ? 0.0 : 1.0;
+            double maxDistance = unit(random) < 0.5 ? LightRay::RayLength : 1000.0 * unit(random);
+            int excludeWall = unit(random) < 0.5
+                ? -1 : std::uniform_int_distribution<int>(0, walls.size() - 1)(random);
+
+            double expectedDistance;
+            int expected = reference.findNextWall(origin, direction, maxDistance, minDistance, excludeWall,
+                                                  expectedDistance);
+            for (int k = 0; k < 3; ++k) {
+                if (!WallKernel::isSupported(kinds[k])) continue;
+                double distance;
+                int wall = tables[k].findNextWall(origin, direction, maxDistance, minDistance, excludeWall,
+                                                  distance);
+                if (wall != expected || (wall >= 0 && distance != expectedDistance)) {
+                    ++mismatches[kinds[k]];
+                }
+            }
+            // Отдельный луч через структуры поиска - та же стена на том же расстоянии, что и перебор
+            for (int b = 0; b < 2; ++b) {
+                double distance;
+                int wall = indexes[b]->findNextWall(origin, direction, maxDistance, minDistance, excludeWall,
+                                                    distance);
+                if (wall != expected || (wall >= 0 && distance != expectedDistance)) {
+                    ++indexMismatches[b];
+                }
+            }
+            ++queries;
+        }
+
+        // Полные траектории: одинаковые стены на каждом шаге дают побитово одинаковые пути.
+        // BasicTracer<double> должен совпасть с LightRay, float-ядра - со скалярным float
+        BasicTracer<double> doubleTracer(reference);
+        BasicTracer<float> floatReference(reference);
+        for (int r = 0; r < RaysPerRoom; ++r) {
+            int startWall = std::uniform_int_distribution<int>(0, walls.size() - 1)(random);
+            QPointF start = walls[startWall]->pointAt(0.5);
+            double angle = unit(random) * 2 * M_PI;
+
+            LightRay expected(start, angle, reference, nullptr, ReflectionsPerRay);
+            if (!samePath(doubleTracer.trace(start, angle, ReflectionsPerRay), expected.path())) {
+                ++precisionMismatches;
+            }
+
+            QVector<QPointF> expectedFloat = floatReference.trace(start, angle, ReflectionsPerRay);
+            for (int k = 0; k < 3; ++k) {
+                if (!WallKernel::isSupported(kinds[k])) continue;
+                LightRay ray(start, angle, tables[k], nullptr, ReflectionsPerRay);
+                if (!samePath(ray.path(), expected.path())) {
+                    ++mismatches[kinds[k]];
+                }
+                BasicTracer<float> floatTracer(tables[k]);
+                if (!samePath(floatTracer.trace(start, angle, ReflectionsPerRay), expectedFloat)) {
+                    ++mismatches[kinds[k]];
+                }
+            }
+            for (int b = 0; b < 2; ++b) {
+                LightRay ray(start, angle, reference, indexes[b], ReflectionsPerRay);
+                if (!samePath(ray.path(), expected.path())) {
+                    ++indexMismatches[b];
+                }
+            }
+            ++rays;
+        }
+
+        // Пакетная трассировка веера против отдельных лучей: все ядра и все структуры поиска
+        int startWall = std::uniform_int_distribution<int>(0, walls.size() - 1)(random);
+        QPointF start = walls[startWall]->pointAt(0.5);
+        double baseAngle = unit(random) * 2 * M_PI;
+        double step = unit(random) < 0.5 ? 1e-4 : 1e-2;
+        QVector<double> angles;
+        for (int i = 0; i < FanSize; ++i) {
+            angles.append(baseAngle + i * step);
+        }
+
+        QVector<QVector<QPointF>> expectedPaths;
+        for (double angle : angles) {
+            LightRay ray(start, angle, reference, nullptr, ReflectionsPerRay);
+            expectedPaths.append(ray.path());
+        }
+
+        auto checkFan = [&](const WallTable& table, const WallIndex* index) {
+            QVector<QVector<QPointF>> paths = PacketTracer(table, index).traceFan(start, angles, ReflectionsPerRay);
+            for (int i = 0; i < angles.size(); ++i) {
+                if (!samePath(paths[i], expectedPaths[i])) ++packetMismatches;
+            }
+            ++fans;
+        };
+
+        checkFan(reference, nullptr);
+        for (int k = 0; k < 3; ++k) {
+            if (WallKernel::isSupported(kinds[k])) checkFan(tables[k], nullptr);
+        }
+        for (int b = 0; b < 2; ++b) {
+            checkFan(reference, indexes[b]);
+            delete indexes[b];
+        }
+
+        qDeleteAll(walls);
+    }
+
+    bool ok = packetMismatches == 0 && precisionMismatches == 0
+        && indexMismatches[0] == 0 && indexMismatches[1] == 0;
+    out << QString("%1 rooms, %2 queries, %3 traced rays per kernel\n").arg(RoomCount).arg(queries).arg(rays);
+    for (WallKernel::Kind kind : kinds) {
+        if (!WallKernel::isSupported(kind)) {
+            out << QString("%1: not supported by this CPU\n").arg(WallKernel::name(kind), 8);
+            continue;
+        }
+        out << QString("%1: %2\n").arg(WallKernel::name(kind), 8)
+                   .arg(mismatches[kind] == 0 ? QString("ok") : QString("%1 mismatches").arg(mismatches[kind]));
+        ok = ok && mismatches[kind] == 0;
+    }
+    for (int b = 0; b < 2; ++b) {
+        out << QString("%1 vs linear: %2\n").arg(WallIndex::backendName(backends[b]))
+                   .arg(indexMismatches[b] == 0 ? QString("ok") : QString("%1 mismatches").arg(indexMismatches[b]));
+    }
+    out << QString("packet tracer: %1 fans of %2 rays, %3\n").arg(fans).arg(FanSize)
+               .arg(packetMismatches == 0 ? QString("ok") : QString("%1 mismatches").arg(packetMismatches));
+    out << QString("BasicTracer<double> vs LightRay: %1\n")
+               .arg(precisionMismatches == 0 ? QString("ok") : QString("%1 mismatches").arg(precisionMismatches));
+    return ok;
+}
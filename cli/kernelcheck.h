@@ -0,0 +1,10 @@
+#ifndef KERNELCHECK_H
+#define KERNELCHECK_H
+
+#include <QTextStream>
+
+// Сверка векторных ядер поиска стены со скалярным на случайных комнатах
+// для mirrortrace --check-kernels. false, если хоть одно ядро выбрало другую стену
+bool runKernelCheck(QTextStream& out);
+
+#endif // KERNELCHECK_H
@@ -0,0 +1,416 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QScopeGuard>
+#include <QScopedPointer>
+#include <QTextStream>
+#include <QtMath>
+#include <climits>
+#include <csignal>
+#include "anglesweep.h"
+#include "basictracer.h"
+#include "benchmark.h"
+#include "kernelcheck.h"
+#include "lightray.h"
+#include "longtrace.h"
+#include "orbittracer.h"
+#include "roombuilder.h"
+#include "roomfile.h"
+#include "walltable.h"
+#include "wallindex.h"
+
+// mirrortrace - трассировка луча без GUI.
+// Комната берется из файла (--room) или строится как правильный многоугольник (--polygon),
+// точки отражения пишутся в CSV: index,x,y.
+// С --sweep трассируется веер лучей на всех ядрах, CSV: ray,index,x,y.
+// Одиночный луч не хранится в памяти: точки пишутся по мере отражений,
+// с --stats вместо точек печатается только сводка.
+// С --checkpoint луч идет в длинном режиме: состояние периодически пишется в файл,
+// Ctrl+C останавливает трассировку с сохранением, --resume продолжает с файла.
+// С --orbits луч обрывается на периодической орбите, --periods пишет карту периодов веера.
+// Веер с --stats сворачивается в сводку по ходу трассировки, пути не хранятся;
+// --periods без --stats строит только карту, без путей
+
+static bool parsePoint(const QString& text, QPointF& point)
+{
+    QStringList parts = text.split(',');
+    if (parts.size() != 2) return false;
+
+    bool okX = false;
+    bool okY = false;
+    point = QPointF(parts[0].toDouble(&okX), parts[1].toDouble(&okY));
+    return okX && okY;
+}
+
+// Длинная трассировка, которую останавливает SIGINT
+static LongTrace* interruptibleTrace = nullptr;
+
+static void interrupt(int)
+{
+    if (interruptibleTrace) interruptibleTrace->cancel();
+}
+
+// Карта периодов веера; угол в градусах, как в --sweep. Период 0 - орбита не найдена
+static bool writePeriods(const QString& filename, const QPointF& sweepRange,
+                         const QVector<Orbit>& orbits, QString* errorMessage)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        if (errorMessage) *errorMessage = file.errorString();
+        return false;
+    }
+
+    QTextStream out(&file);
+    out.setRealNumberPrecision(17);
+    out << "ray,angle,period,start,x,y\n";
+    int last = qMax(1, orbits.size() - 1);
+    for (int ray = 0; ray < orbits.size(); ++ray) {
+        const Orbit& orbit = orbits[ray];
+        double angle = sweepRange.x() + (sweepRange.y() - sweepRange.x()) * ray / last;
+        out << ray << ',' << angle << ',' << orbit.period << ',' << orbit.start << ','
+            << orbit.point.x() << ',' << orbit.point.y() << '\n';
+    }
+    return true;
+}
+
+static int fail(const QString& message)
+{
+    QTextStream(stderr) << "mirrortrace: " << message << Qt::endl;
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("mirrortrace");
+    app.setApplicationVersion("1.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless light ray tracing in a mirror room.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption roomOption("room", "Room file (x1 y1 x2 y2 [type] per line).", "file");
+    QCommandLineOption polygonOption("polygon", "Regular polygon room with <n> walls.", "n");
+    QCommandLineOption sizeOption("size", "Circumradius of the --polygon room.", "radius", "200");
+    QCommandLineOption startOption("start", "Ray start point.", "x,y");
+    QCommandLineOption startWallOption("start-wall", "Start on wall <index> (0-based).", "index");
+    QCommandLineOption wallPositionOption("wall-position",
+                                          "Start position along --start-wall, 0..1.", "t", "0.5");
+    QCommandLineOption angleOption("angle", "Ray angle in degrees.", "degrees", "45");
+    QCommandLineOption reflectionsOption("reflections", "Maximum number of reflections.", "n", "50");
+    QCommandLineOption outputOption({"o", "output"}, "Write the path to <file> instead of stdout.", "file");
+    QCommandLineOption accelOption("accel", "Next-wall lookup: linear, grid or bvh.", "backend", "grid");
+    QCommandLineOption sweepOption("sweep", "Trace --samples rays with angles from..to in degrees.", "from,to");
+    QCommandLineOption samplesOption("samples", "Number of rays in --sweep.", "n", "360");
+    QCommandLineOption threadsOption("threads", "Worker threads for --sweep, 0 - all cores.", "n", "0");
+    QCommandLineOption statsOption("stats", "Print path statistics instead of the points.");
+    QCommandLineOption checkpointOption("checkpoint",
+                                        "Long run: save the ray state to <file> every --checkpoint-every "
+                                        "reflections and on Ctrl+C.", "file");
+    QCommandLineOption checkpointEveryOption("checkpoint-every", "Reflections between checkpoints.",
+                                             "n", "10000000");
+    QCommandLineOption resumeOption("resume", "Continue a long run from checkpoint <file> "
+                                    "up to --reflections in total.", "file");
+    QCommandLineOption precisionOption("precision",
+                                       "Tracing precision: float, double or long-double. "
+                                       "Only double uses --accel.", "type", "double");
+    QCommandLineOption orbitsOption("orbits", "Stop each ray once it settles into a periodic orbit "
+                                    "and report the period (double precision only).");
+    QCommandLineOption orbitToleranceOption("orbit-tolerance", "State match tolerance for --orbits.",
+                                            "t", QString::number(OrbitTracer::DefaultTolerance));
+    QCommandLineOption periodsOption("periods", "With --sweep: write ray,angle,period,start,x,y "
+                                     "to <file> (implies --orbits; no path CSV without --stats).", "file");
+    QCommandLineOption benchmarkOption("benchmark", "Measure tracing speed and exit.");
+    QCommandLineOption checkKernelsOption("check-kernels",
+                                          "Compare SIMD and scalar next-wall kernels on random rooms and exit.");
+
+    parser.addOptions({roomOption, polygonOption, sizeOption, startOption, startWallOption,
+                       wallPositionOption, angleOption, reflectionsOption, outputOption,
+                       accelOption, sweepOption, samplesOption, threadsOption, statsOption,
+                       checkpointOption, checkpointEveryOption, resumeOption, precisionOption,
+                       orbitsOption, orbitToleranceOption, periodsOption, benchmarkOption,
+                       checkKernelsOption});
+    parser.process(app);
+
+    if (parser.isSet(benchmarkOption)) {
+        QTextStream out(stdout);
+        runIndexBenchmark(out);
+        return 0;
+    }
+
+    if (parser.isSet(checkKernelsOption)) {
+        QTextStream out(stdout);
+        return runKernelCheck(out) ? 0 : 1;
+    }
+
+    WallIndex::Backend backend = WallIndex::LinearScan;
+    bool backendFound = false;
+    for (WallIndex::Backend candidate : {WallIndex::LinearScan, WallIndex::UniformGrid, WallIndex::Bvh}) {
+        if (parser.value(accelOption) == WallIndex::backendName(candidate)) {
+            backend = candidate;
+            backendFound = true;
+        }
+    }
+    if (!backendFound) {
+        return fail("--accel must be linear, grid or bvh");
+    }
+
+    TracePrecision::Kind precision = TracePrecision::Double;
+    bool precisionFound = false;
+    for (TracePrecision::Kind candidate : {TracePrecision::Float, TracePrecision::Double,
+                                           TracePrecision::LongDouble}) {
+        if (parser.value(precisionOption) == TracePrecision::name(candidate)) {
+            precision = candidate;
+            precisionFound = true;
+        }
+    }
+    if (!precisionFound) {
+        return fail("--precision must be float, double or long-double");
+    }
+
+    // Комната; стены удаляются на любом выходе из main
+    QVector<Wall*> walls;
+    auto deleteWalls = qScopeGuard([&walls] { qDeleteAll(walls); });
+    if (parser.isSet(roomOption)) {
+        QString error;
+        if (!RoomFile::load(parser.value(roomOption), walls, &error)) {
+            return fail(error);
+        }
+    } else if (parser.isSet(polygonOption)) {
+        bool ok = false;
+        int count = parser.value(polygonOption).toInt(&ok);
+        double radius = parser.value(sizeOption).toDouble();
+        if (!ok || count < 3 || radius <= 0) {
+            return fail("--polygon needs at least 3 walls and a positive --size");
+        }
+        walls = RoomBuilder::createWalls(RoomBuilder::regularPolygon(count, QPointF(0, 0), radius));
+    } else {
+        return fail("either --room or --polygon is required");
+    }
+
+    if (walls.isEmpty()) {
+        return fail("room has no walls");
+    }
+
+    // Точка старта: явная или на стене, как в GUI
+    QPointF startPoint;
+    if (parser.isSet(startOption)) {
+        if (!parsePoint(parser.value(startOption), startPoint)) {
+            return fail("--start expects x,y");
+        }
+    } else {
+        int wallIndex = parser.isSet(startWallOption) ? parser.value(startWallOption).toInt() : 0;
+        double t = parser.value(wallPositionOption).toDouble();
+        if (wallIndex < 0 || wallIndex >= walls.size()) {
+            return fail(QString("--start-wall must be in 0..%1").arg(walls.size() - 1));
+        }
+        startPoint = walls[wallIndex]->pointAt(qBound(0.0, t, 1.0));
+    }
+
+    double angle = parser.value(angleOption).toDouble();
+
+    // Длинный режим: число отражений не ограничено int, точность - только double
+    bool longRun = parser.isSet(checkpointOption) || parser.isSet(resumeOption);
+    bool reflectionsOk = false;
+    qint64 totalReflections = parser.value(reflectionsOption).toLongLong(&reflectionsOk);
+    if (!reflectionsOk || totalReflections < 1 || (!longRun && totalReflections > INT_MAX)) {
+        return fail(longRun ? QString("--reflections must be a positive number")
+                            : QString("--reflections must be in 1..%1").arg(INT_MAX));
+    }
+    int maxReflections = int(qMin<qint64>(totalReflections, INT_MAX));
+    qint64 checkpointEvery = parser.value(checkpointEveryOption).toLongLong();
+    if (longRun && (parser.isSet(sweepOption) || precision != TracePrecision::Double || checkpointEvery < 1)) {
+        return fail("--checkpoint and --resume trace a single ray in double precision "
+                    "with a positive --checkpoint-every");
+    }
+    // Сводка в контрольной точке не хранится: после продолжения она была бы только по его части
+    if (parser.isSet(resumeOption) && parser.isSet(statsOption)) {
+        return fail("--stats cannot be combined with --resume");
+    }
+
+    // Поиск орбит сравнивает состояния LightRay, поэтому только double и обычный режим
+    bool orbits = parser.isSet(orbitsOption) || parser.isSet(periodsOption);
+    bool toleranceOk = false;
+    double orbitTolerance = parser.value(orbitToleranceOption).toDouble(&toleranceOk);
+    if (orbits && (longRun || precision != TracePrecision::Double || !toleranceOk || orbitTolerance <= 0)) {
+        return fail("--orbits needs double precision, no --checkpoint or --resume "
+                    "and a positive --orbit-tolerance");
+    }
+    if (parser.isSet(periodsOption) && !parser.isSet(sweepOption)) {
+        return fail("--periods needs --sweep");
+    }
+
+    QPointF sweepRange;
+    int samples = parser.value(samplesOption).toInt();
+    if (parser.isSet(sweepOption) && (!parsePoint(parser.value(sweepOption), sweepRange) || samples < 1)) {
+        return fail("--sweep expects from,to and a positive --samples");
+    }
+
+    WallTable table;
+    table.build(walls);
+
+    QScopedPointer<WallIndex> index(WallIndex::create(backend));
+    if (index) {
+        index->build(table);
+    }
+
+    QFile outputFile;
+    if (parser.isSet(outputOption)) {
+        outputFile.setFileName(parser.value(outputOption));
+        // Продолжение длинного прогона дописывает точки в тот же файл,
+        // обрезанный до размера из контрольной точки
+        QIODevice::OpenMode mode = parser.isSet(resumeOption) ? QIODevice::Append : QIODevice::Truncate;
+        if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Text | mode)) {
+            return fail(outputFile.errorString());
+        }
+    } else if (!outputFile.open(stdout, QIODevice::WriteOnly | QIODevice::Text)) {
+        return fail(outputFile.errorString());
+    }
+
+    QTextStream out(&outputFile);
+    out.setRealNumberPrecision(17);
+
+    // Угол передается в радианах, 0 - вправо, увеличение против часовой стрелки
+    PathStatistics statistics;
+    if (parser.isSet(sweepOption)) {
+        AngleSweep sweep(table, index.data());
+        sweep.setThreadCount(parser.value(threadsOption).toInt());
+        sweep.setPrecision(precision);
+        sweep.setOrbitTolerance(orbits ? orbitTolerance : 0.0);
+        double fromAngle = qDegreesToRadians(sweepRange.x());
+        double toAngle = qDegreesToRadians(sweepRange.y());
+        QVector<Orbit> rayOrbits;
+
+        if (parser.isSet(statsOption)) {
+            // Сводка копится по лучу в потоке этого луча и сворачивается после; пути не хранятся
+            QVector<PathStatistics> rayStatistics(samples);
+            QVector<PathSink*> sinks;
+            for (PathStatistics& rayStatistic : rayStatistics) {
+                sinks.append(&rayStatistic);
+            }
+            sweep.run(startPoint, fromAngle, toAngle, samples, maxReflections, sinks, &rayOrbits);
+            for (const PathStatistics& rayStatistic : rayStatistics) {
+                statistics.merge(rayStatistic);
+            }
+        } else if (parser.isSet(periodsOption)) {
+            // Нужна только карта периодов: пути не строятся
+            rayOrbits = sweep.runOrbits(startPoint, fromAngle, toAngle, samples, maxReflections);
+        } else {
+            QVector<QVector<QPointF>> paths = sweep.run(startPoint, fromAngle, toAngle, samples, maxReflections);
+            out << "ray,index,x,y\n";
+            for (int ray = 0; ray < paths.size(); ++ray) {
+                PathCsvWriter writer(out, ray);
+                const QVector<QPointF>& path = paths[ray];
+                // Пути веера хранят только точки: стена отражения неизвестна
+                for (int i = 0; i < path.size(); ++i) {
+                    writer.addPoint(path[i], i == 0 ? PathSink::RayStart : PathSink::UnknownWall);
+                }
+            }
+        }
+
+        if (parser.isSet(periodsOption)) {
+            QString error;
+            if (!writePeriods(parser.value(periodsOption), sweepRange, rayOrbits, &error)) {
+                return fail(error);
+            }
+        }
+    } else if (longRun) {
+        LongTrace trace(table, index.data());
+        trace.start(startPoint, qDegreesToRadians(angle));
+        if (parser.isSet(resumeOption)) {
+            QString error;
+            if (!trace.resume(parser.value(resumeOption), &error)) {
+                return fail(error);
+            }
+            // Строки после контрольной точки отбрасываются: продолжение напишет их заново
+            if (parser.isSet(outputOption)) {
+                if (trace.outputSize() < 0) {
+                    return fail(QString("%1 does not record the output size; resume without --output")
+                                    .arg(parser.value(resumeOption)));
+                }
+                if (outputFile.size() < trace.outputSize()) {
+                    return fail(QString("%1 is shorter than the checkpoint expects").arg(outputFile.fileName()));
+                }
+                if (!outputFile.resize(trace.outputSize())) {
+                    return fail(outputFile.errorString());
+                }
+            }
+        }
+
+        // Номера точек продолжаются с контрольной точки: начало луча - 0, отражение k - k
+        bool resumed = parser.isSet(resumeOption);
+        PathCsvWriter writer(out, -1, resumed ? trace.reflections() + 1 : 0);
+        PathSink& sink = parser.isSet(statsOption) ? static_cast<PathSink&>(statistics) : writer;
+        if (!resumed) {
+            if (!parser.isSet(statsOption)) out << "index,x,y\n";
+            sink.addPoint(startPoint, -1);
+        }
+
+        // Без --checkpoint продолжение пишет состояние обратно в файл, с которого начало
+        QString checkpointFile = parser.isSet(checkpointOption) ? parser.value(checkpointOption)
+                                                                : parser.value(resumeOption);
+        QTextStream progress(stderr);
+        trace.setCheckpointFile(checkpointFile, checkpointEvery);
+        const bool outputIsFile = parser.isSet(outputOption);
+        trace.setOutputFlush([&out, &outputFile, outputIsFile](qint64& outputSize) {
+            out.flush();
+            if (out.status() != QTextStream::Ok || !outputFile.flush()) return false;
+            outputSize = outputIsFile ? outputFile.size() : -1;
+            return true;
+        });
+        trace.setProgress([&progress, totalReflections](qint64 reflections) {
+            progress << QString("%1 / %2 reflections").arg(reflections).arg(totalReflections) << Qt::endl;
+        }, checkpointEvery);
+
+        interruptibleTrace = &trace;
+        std::signal(SIGINT, interrupt);
+        QString error;
+        LongTrace::Status status = trace.run(totalReflections, &sink, &error);
+        std::signal(SIGINT, SIG_DFL);
+        interruptibleTrace = nullptr;
+
+        if (status == LongTrace::Failed) {
+            return fail(error);
+        }
+        if (status == LongTrace::Escaped) {
+            progress << "mirrortrace: the ray left the room" << Qt::endl;
+        } else if (status == LongTrace::Stopped) {
+            progress << "mirrortrace: stopped, continue with --resume " << checkpointFile << Qt::endl;
+        }
+    } else {
+        PathCsvWriter writer(out);
+        PathSink& sink = parser.isSet(statsOption) ? static_cast<PathSink&>(statistics) : writer;
+        if (!parser.isSet(statsOption)) out << "index,x,y\n";
+
+        if (precision == TracePrecision::Float) {
+            BasicTracer<float>(table).trace(startPoint, qDegreesToRadians(angle), maxReflections, sink);
+        } else if (precision == TracePrecision::LongDouble) {
+            BasicTracer<long double>(table).trace(startPoint, qDegreesToRadians(angle), maxReflections, sink);
+        } else if (orbits) {
+            OrbitTracer tracer(table, index.data(), orbitTolerance);
+            Orbit orbit = tracer.trace(startPoint, qDegreesToRadians(angle), maxReflections, sink);
+            QTextStream report(stderr);
+            report.setRealNumberPrecision(17);
+            if (orbit.period > 0) {
+                report << "orbit: period " << orbit.period << " from reflection " << orbit.start
+                       << " at " << orbit.point.x() << ',' << orbit.point.y() << Qt::endl;
+            } else {
+                report << "orbit: none within " << maxReflections << " reflections" << Qt::endl;
+            }
+        } else {
+            LightRay::trace(startPoint, qDegreesToRadians(angle), table, index.data(), maxReflections, sink);
+        }
+    }
+
+    if (parser.isSet(statsOption)) {
+        out << "rays " << statistics.rays() << '\n';
+        out << "reflections " << statistics.reflections() << '\n';
+        out << "length " << statistics.length() << '\n';
+        QRectF bounds = statistics.bounds();
+        out << "bounds " << bounds.left() << ',' << bounds.top() << ' '
+            << bounds.right() << ',' << bounds.bottom() << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+#include "anglesweep.h"
+#include <QMutex>
+#include <QThread>
+#include "packettracer.h"
+
+namespace {
+
+// Лучей за один захват: соседние углы трассируются пакетами, несколько пакетов подряд
+const int Grain = 2 * WallKernel::MaxLanes;
+
+// Диапазон еще не взятых лучей потока. Владелец берет с начала, чужие потоки - с конца
+struct WorkRange {
+    QMutex mutex;
+    int begin = 0;
+    int end = 0;
+};
+
+// Орбита луча, когда поиск выключен
+const Orbit NoOrbit = {0, 0, QPointF()};
+
+}
+
+AngleSweep::AngleSweep(const WallTable& table, const WallIndex* index)
+    : m_table(&table)
+    , m_index(index)
+    , m_threadCount(0)
+    , m_precision(TracePrecision::Double)
+    , m_orbitTolerance(0.0)
+{
+}
+
+int AngleSweep::threadCount() const
+{
+    return m_threadCount > 0 ? m_threadCount : qMax(1, QThread::idealThreadCount());
+}
+
+double AngleSweep::sampleAngle(double fromAngle, double toAngle, int samples, int i)
+{
+    return samples > 1 ? fromAngle + (toAngle - fromAngle) * i / (samples - 1) : fromAngle;
+}
+
+QVector<QVector<QPointF>> AngleSweep::run(const QPointF& startPoint, double fromAngle, double toAngle,
+                                          int samples, int maxReflections, QVector<Orbit>* orbits) const
+{
+    QVector<QVector<QPointF>> paths(qMax(0, samples));
+    QVector<PathSink*> sinks;
+    for (QVector<QPointF>& path : paths) {
+        sinks.append(new PathCollector(path));
+    }
+    run(startPoint, fromAngle, toAngle, samples, maxReflections, sinks, orbits);
+    qDeleteAll(sinks);
+    return paths;
+}
+
+void AngleSweep::run(const QPointF& startPoint, double fromAngle, double toAngle, int samples, int maxReflections,
+                     const QVector<PathSink*>& sinks, QVector<Orbit>* orbits) const
+{
+    // Приемники своего захвата; mid() только читает общий вектор
+    auto chunkSinks = [&sinks](int begin, const QVector<double>& angles) {
+        return sinks.mid(begin, angles.size());
+    };
+
+    // Точность выбирается один раз на всю развертку; дальше работает код нужного типа
+    QVector<Orbit> found;
+    if (m_precision == TracePrecision::Float) {
+        BasicTracer<float> tracer(*m_table);
+        found = runWith<Orbit>(fromAngle, toAngle, samples, [&](int begin, const QVector<double>& angles) {
+            tracer.traceFan(startPoint, angles, maxReflections, chunkSinks(begin, angles));
+            return QVector<Orbit>(angles.size(), NoOrbit);
+        });
+    } else if (m_precision == TracePrecision::LongDouble) {
+        BasicTracer<long double> tracer(*m_table);
+        found = runWith<Orbit>(fromAngle, toAngle, samples, [&](int begin, const QVector<double>& angles) {
+            tracer.traceFan(startPoint, angles, maxReflections, chunkSinks(begin, angles));
+            return QVector<Orbit>(angles.size(), NoOrbit);
+        });
+    } else if (m_orbitTolerance <= 0.0) {
+        PacketTracer tracer(*m_table, m_index);
+        found = runWith<Orbit>(fromAngle, toAngle, samples, [&](int begin, const QVector<double>& angles) {
+            tracer.traceFan(startPoint, angles, maxReflections, chunkSinks(begin, angles));
+            return QVector<Orbit>(angles.size(), NoOrbit);
+        });
+    } else {
+        // Орбиты: лучи по одному, каждый обрывается на своей орбите
+        OrbitTracer tracer(*m_table, m_index, m_orbitTolerance);
+        found = runWith<Orbit>(fromAngle, toAngle, samples, [&](int begin, const QVector<double>& angles) {
+            QVector<Orbit> chunk;
+            for (int i = 0; i < angles.size(); ++i) {
+                chunk.append(tracer.trace(startPoint, angles[i], maxReflections, *sinks[begin + i]));
+            }
+            return chunk;
+        });
+    }
+
+    if (orbits) orbits->swap(found);
+}
+
+QVector<Orbit> AngleSweep::runOrbits(const QPointF& startPoint, double fromAngle, double toAngle,
+                                     int samples, int maxReflections) const
+{
+    OrbitTracer tracer(*m_table, m_index, m_orbitTolerance > 0.0 ? m_orbitTolerance
+                                                                 : OrbitTracer::DefaultTolerance);
+    return runWith<Orbit>(fromAngle, toAngle, samples, [&](int, const QVector<double>& angles) {
+        QVector<Orbit> chunk;
+        for (double angle : angles) {
+            chunk.append(tracer.findOrbit(startPoint, angle, maxReflections));
+        }
+        return chunk;
+    });
+}
+
+template <typename Result, typename TraceChunk>
+QVector<Result> AngleSweep::runWith(double fromAngle, double toAngle, int samples,
+                                    const TraceChunk& traceChunk) const
+{
+    QVector<Result> paths(qMax(0, samples));
+    if (samples <= 0) return paths;
+
+    int workers = qMin(threadCount(), (samples + Grain - 1) / Grain);
+    WorkRange* ranges = new WorkRange[workers];
+    for (int w = 0; w < workers; ++w) {
+        ranges[w].begin = qint64(samples) * w / workers;
+        ranges[w].end = qint64(samples) * (w + 1) / workers;
+    }
+
+    // Каждый луч пишет только свой элемент; data() берем до запуска потоков,
+    // чтобы потоки не трогали счетчик ссылок вектора
+    Result* results = paths.data();
+
+    auto work = [&, ranges, results](int self) {
+        while (true) {
+            int begin;
+            int end;
+            {
+                QMutexLocker locker(&ranges[self].mutex);
+                begin = ranges[self].begin;
+                end = qMin(begin + Grain, ranges[self].end);
+                ranges[self].begin = end;
+            }
+
+            if (begin == end) {
+                // Свой диапазон кончился - забираем вторую половину чужого
+                bool stolen = false;
+                for (int k = 1; k < workers && !stolen; ++k) {
+                    WorkRange& victim = ranges[(self + k) % workers];
+                    QMutexLocker locker(&victim.mutex);
+                    int remaining = victim.end - victim.begin;
+                    if (remaining <= 0) continue;
+
+                    begin = remaining > Grain ? victim.begin + remaining / 2 : victim.begin;
+                    end = victim.end;
+                    victim.end = begin;
+                    stolen = true;
+                }
+                if (!stolen) return;
+
+                QMutexLocker locker(&ranges[self].mutex);
+                ranges[self].begin = begin;
+                ranges[self].end = end;
+                continue;
+            }
+
+            QVector<double> angles;
+            for (int i = begin; i < end; ++i) {
+                angles.append(sampleAngle(fromAngle, toAngle, samples, i));
+            }
+            QVector<Result> chunk = traceChunk(begin, angles);
+            for (int i = begin; i < end; ++i) {
+                results[i] = chunk[i - begin];
+            }
+        }
+    };
+
+    // Текущий поток работает как нулевой
+    QVector<QThread*> threads;
+    for (int w = 1; w < workers; ++w) {
+        QThread* thread = QThread::create([&work, w] { work(w); });
+        threads.append(thread);
+        thread->start();
+    }
+    work(0);
+
+    for (QThread* thread : threads) {
+        thread->wait();
+        delete thread;
+    }
+    delete[] ranges;
+
+    return paths;
+}
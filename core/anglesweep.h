@@ -0,0 +1,72 @@
+#ifndef ANGLESWEEP_H
+#define ANGLESWEEP_H
+
+#include <QPointF>
+#include <QVector>
+#include "basictracer.h"
+#include "orbittracer.h"
+#include "walltable.h"
+#include "wallindex.h"
+
+// Развертка по углу: samples лучей из одной точки с углами от fromAngle до toAngle
+// включительно, каждый до maxReflections отражений, на всех ядрах.
+// Таблица и индекс стен общие для всех потоков и только читаются.
+// Стоимость лучей сильно разная (один уходит в угол сразу, другой отражается тысячи раз),
+// поэтому работа делится не фиксированными кусками, а с перехватом (work stealing):
+// у каждого потока свой диапазон лучей, опустевший поток забирает половину
+// оставшегося диапазона у соседа.
+// В точности Double лучи идут через PacketTracer с индексом стен, в Float и LongDouble -
+// через BasicTracer нужного типа линейным проходом.
+// С допуском орбит (setOrbitTolerance) лучи в точности Double идут по одному через
+// OrbitTracer и обрываются, как только выходят на периодическую орбиту.
+class AngleSweep
+{
+public:
+    // table и index должны жить дольше развертки
+    AngleSweep(const WallTable& table, const WallIndex* index = nullptr);
+
+    // 0 - QThread::idealThreadCount()
+    void setThreadCount(int count) { m_threadCount = count; }
+    int threadCount() const;
+
+    // По умолчанию TracePrecision::Double
+    void setPrecision(TracePrecision::Kind precision) { m_precision = precision; }
+    TracePrecision::Kind precision() const { return m_precision; }
+
+    // 0 (по умолчанию) - без поиска орбит; иначе допуск OrbitTracer. Только для Double
+    void setOrbitTolerance(double tolerance) { m_orbitTolerance = tolerance; }
+    double orbitTolerance() const { return m_orbitTolerance; }
+
+    // Пути лучей в порядке углов; первая точка каждого пути - startPoint.
+    // orbits, если задан, получает орбиту каждого луча (период 0, если поиск выключен)
+    QVector<QVector<QPointF>> run(const QPointF& startPoint, double fromAngle, double toAngle,
+                                  int samples, int maxReflections, QVector<Orbit>* orbits = nullptr) const;
+    // То же без хранения путей: точки луча i уходят в sinks[i] (sinks.size() == samples).
+    // Приемник вызывается в потоке, который трассирует его луч, и больше ни в каком,
+    // поэтому сводке по вееру хватает своего приемника на луч и свертки после run()
+    void run(const QPointF& startPoint, double fromAngle, double toAngle, int samples, int maxReflections,
+             const QVector<PathSink*>& sinks, QVector<Orbit>* orbits = nullptr) const;
+
+    // Карта периодов: только орбиты лучей, без путей, в точности double.
+    // Допуск - orbitTolerance() или OrbitTracer::DefaultTolerance, если он не задан
+    QVector<Orbit> runOrbits(const QPointF& startPoint, double fromAngle, double toAngle,
+                             int samples, int maxReflections) const;
+
+    // Угол луча i из samples
+    static double sampleAngle(double fromAngle, double toAngle, int samples, int i);
+
+private:
+    const WallTable* m_table;
+    const WallIndex* m_index;
+    int m_threadCount;
+    TracePrecision::Kind m_precision;
+    double m_orbitTolerance;
+
+    // traceChunk(begin, angles) трассирует лучи begin, begin + 1, ... одного захвата
+    // и возвращает QVector<Result>
+    template <typename Result, typename TraceChunk>
+    QVector<Result> runWith(double fromAngle, double toAngle, int samples,
+                            const TraceChunk& traceChunk) const;
+};
+
+#endif // ANGLESWEEP_H
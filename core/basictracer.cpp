@@ -0,0 +1,350 @@
+#include "basictracer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "lightray.h"
+
+namespace {
+
+// Положение стены в точности Real
+template <typename Real>
+struct WallFrame {
+    Real startX;
+    Real startY;
+    Real directionX;
+    Real directionY;
+    Real inverseLength;
+    Real centerX;
+    Real centerY;
+};
+
+// Направление, длина и центр дуги пересчитываются из концов стены в Real,
+// чтобы в long double не тянуть ошибку округления double
+template <typename Real>
+WallFrame<Real> wallFrame(const WallTable& table, int i)
+{
+    const QPointF start = table.startPoint(i);
+    const QPointF end = table.endPoint(i);
+
+    WallFrame<Real> frame;
+    frame.startX = Real(start.x());
+    frame.startY = Real(start.y());
+
+    const Real dx = Real(end.x()) - frame.startX;
+    const Real dy = Real(end.y()) - frame.startY;
+    const Real length = std::sqrt(dx * dx + dy * dy);
+    frame.inverseLength = length > 0 ? 1 / length : 0;
+    frame.directionX = dx * frame.inverseLength;
+    frame.directionY = dy * frame.inverseLength;
+
+    frame.centerX = 0;
+    frame.centerY = 0;
+    if (table.surface(i) != WallTable::FlatSurface) {
+        // Как в Wall::curvatureCenter(): центр вогнутой стены со стороны нормали
+        const Real radius = Real(table.curvatureRadius(i));
+        const Real halfChord = length / 2;
+        Real offset = std::sqrt(std::max(Real(0), radius * radius - halfChord * halfChord));
+        if (table.surface(i) == WallTable::ConvexSurface) offset = -offset;
+        frame.centerX = (frame.startX + Real(end.x())) / 2 + frame.directionY * offset;
+        frame.centerY = (frame.startY + Real(end.y())) / 2 - frame.directionX * offset;
+    }
+    return frame;
+}
+
+// double берет столбцы таблицы как есть - так пути совпадают с LightRay
+template <>
+WallFrame<double> wallFrame<double>(const WallTable& table, int i)
+{
+    const QPointF center = table.curvatureCenter(i);
+    return {table.startPoint(i).x(), table.startPoint(i).y(), table.direction(i).x(), table.direction(i).y(),
+            table.inverseLength(i), center.x(), center.y()};
+}
+
+// Поиск среди плоских стен: double и float - векторными ядрами, остальные типы - скалярно
+int nearestFlat(WallKernel::Kind kind, const WallKernel::Columns& walls, int count,
+                double ox, double oy, double dx, double dy,
+                double minDistance, int excludeWall, double& distance)
+{
+    return WallKernel::nearestHit(kind, walls, 0, count, QPointF(ox, oy), QPointF(dx, dy),
+                                  LightRay::RayLength, minDistance, excludeWall, distance);
+}
+
+int nearestFlat(WallKernel::Kind kind, const WallKernel::FloatColumns& walls, int count,
+                float ox, float oy, float dx, float dy,
+                float minDistance, int excludeWall, float& distance)
+{
+    return WallKernel::nearestHit(kind, walls, 0, count, ox, oy, dx, dy,
+                                  std::numeric_limits<float>::infinity(), minDistance, excludeWall, distance);
+}
+
+template <typename Real>
+int nearestFlat(WallKernel::Kind, const WallKernel::BasicColumns<Real>& walls, int count,
+                Real ox, Real oy, Real dx, Real dy,
+                Real minDistance, int excludeWall, Real& distance)
+{
+    int closest = -1;
+    distance = std::numeric_limits<Real>::max();
+    for (int i = 0; i < count; ++i) {
+        Real t;
+        if (i != excludeWall && WallKernel::intersect(walls, i, ox, oy, dx, dy, t)
+            && t > minDistance && t < distance) {
+            distance = t;
+            closest = i;
+        }
+    }
+    return closest;
+}
+
+}
+
+QString TracePrecision::name(Kind kind)
+{
+    switch (kind) {
+    case Float: return "float";
+    case Double: return "double";
+    case LongDouble: return "long-double";
+    default: return "unknown";
+    }
+}
+
+template <typename Real>
+BasicTracer<Real>::BasicTracer(const WallTable& table)
+    : m_kernel(table.kernel())
+{
+    // Пороги не мельче ошибки округления самого типа: для float они заметно грубее
+    const Real roundoff = 64 * std::numeric_limits<Real>::epsilon();
+    m_minHitDistance = std::max(Real(table.minHitDistance()), Real(table.extent()) * roundoff);
+
+    const int count = table.size();
+    m_normalX.resize(count);
+    m_normalY.resize(count);
+    m_flatPosition.fill(-1, count);
+    m_arcStartX.resize(count);
+    m_arcStartY.resize(count);
+    m_centerX.fill(0, count);
+    m_centerY.fill(0, count);
+    m_curvatureRadius.fill(0, count);
+
+    QVector<WallFrame<Real>> frames(count);
+    for (int i = 0; i < count; ++i) {
+        frames[i] = wallFrame<Real>(table, i);
+        m_normalX[i] = frames[i].directionY;
+        m_normalY[i] = -frames[i].directionX;
+
+        if (table.surface(i) == WallTable::FlatSurface) {
+            m_flatPosition[i] = m_flatWalls.size();
+            m_flatWalls.append(i);
+            continue;
+        }
+
+        if (table.surface(i) == WallTable::ConcaveSurface) {
+            m_concaveWalls.append(i);
+        } else {
+            m_convexWalls.append(i);
+        }
+        m_arcStartX[i] = frames[i].startX;
+        m_arcStartY[i] = frames[i].startY;
+        m_centerX[i] = frames[i].centerX;
+        m_centerY[i] = frames[i].centerY;
+        m_curvatureRadius[i] = Real(table.curvatureRadius(i));
+    }
+
+    const int lanes = WallKernel::MaxFloatLanes;
+    const int padded = (m_flatWalls.size() + lanes - 1) / lanes * lanes;
+    m_startX.fill(0, padded);
+    m_startY.fill(0, padded);
+    m_directionX.fill(0, padded);
+    m_directionY.fill(0, padded);
+    m_inverseLength.fill(0, padded);
+
+    for (int k = 0; k < m_flatWalls.size(); ++k) {
+        const WallFrame<Real>& frame = frames[m_flatWalls[k]];
+        m_startX[k] = frame.startX;
+        m_startY[k] = frame.startY;
+        m_directionX[k] = frame.directionX;
+        m_directionY[k] = frame.directionY;
+        m_inverseLength[k] = frame.inverseLength;
+    }
+}
+
+template <typename Real>
+template <WallTable::Surface S>
+bool BasicTracer<Real>::intersectArc(int i, Real originX, Real originY, Real directionX, Real directionY,
+                                     bool farOnly, Real& t) const
+{
+    // Те же выражения, что в WallTable::intersectArc
+    static const Real tolerance = std::max(Real(WallTable::ArcEndTolerance),
+                                           64 * std::numeric_limits<Real>::epsilon());
+
+    const Real radius = m_curvatureRadius[i];
+    const Real cx = originX - m_centerX[i];
+    const Real cy = originY - m_centerY[i];
+
+    const Real b = cx * directionX + cy * directionY;
+    const Real c = cx * cx + cy * cy - radius * radius;
+    const Real discriminant = b * b - c;
+    if (discriminant < 0) return false;
+
+    const Real q = -(b + std::copysign(std::sqrt(discriminant), b));
+    Real roots[2] = {q, q != 0 ? c / q : 0};
+    int rootCount = 2;
+    if (farOnly) {
+        rootCount = 1;
+    } else if (roots[0] > roots[1]) {
+        std::swap(roots[0], roots[1]);
+    }
+
+    const Real qx = originX - m_arcStartX[i];
+    const Real qy = originY - m_arcStartY[i];
+
+    for (int k = 0; k < rootCount; ++k) {
+        Real root = roots[k];
+        if (root <= m_minHitDistance) continue;
+
+        Real side = (qx + directionX * root) * m_normalX[i] + (qy + directionY * root) * m_normalY[i];
+        if (S == WallTable::ConcaveSurface) side = -side;
+        if (side >= -tolerance * radius) {
+            t = root;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Real>
+template <WallTable::Surface S>
+void BasicTracer<Real>::nearestArc(const QVector<int>& walls, Real originX, Real originY,
+                                   Real directionX, Real directionY, int excludeWall,
+                                   int& closest, Real& distance) const
+{
+    for (int i : walls) {
+        Real t;
+        if (intersectArc<S>(i, originX, originY, directionX, directionY, i == excludeWall, t)
+            && (closest < 0 || t < distance || (t == distance && i < closest))) {
+            distance = t;
+            closest = i;
+        }
+    }
+}
+
+template <typename Real>
+int BasicTracer<Real>::findNextWall(Real originX, Real originY, Real directionX, Real directionY,
+                                    int excludeWall, Real& distance) const
+{
+    if (m_concaveWalls.isEmpty() && m_convexWalls.isEmpty()) {
+        return nextWall<false>(originX, originY, directionX, directionY, excludeWall, distance);
+    }
+    return nextWall<true>(originX, originY, directionX, directionY, excludeWall, distance);
+}
+
+template <typename Real>
+template <bool Curved>
+int BasicTracer<Real>::nextWall(Real originX, Real originY, Real directionX, Real directionY,
+                                int excludeWall, Real& distance) const
+{
+    const WallKernel::BasicColumns<Real> columns = {m_startX.constData(), m_startY.constData(),
+                                                    m_directionX.constData(), m_directionY.constData(),
+                                                    m_inverseLength.constData()};
+    // Без дуг плоские столбцы совпадают с таблицей по номерам стен
+    if (!Curved) {
+        return nearestFlat(m_kernel, columns, m_startX.size(), originX, originY, directionX, directionY,
+                           m_minHitDistance, excludeWall, distance);
+    }
+
+    int closest = nearestFlat(m_kernel, columns, m_startX.size(), originX, originY, directionX, directionY,
+                              m_minHitDistance, excludeWall >= 0 ? m_flatPosition[excludeWall] : -1, distance);
+    if (closest >= 0) closest = m_flatWalls[closest];
+
+    nearestArc<WallTable::ConcaveSurface>(m_concaveWalls, originX, originY, directionX, directionY,
+                                          excludeWall, closest, distance);
+    nearestArc<WallTable::ConvexSurface>(m_convexWalls, originX, originY, directionX, directionY,
+                                         excludeWall, closest, distance);
+    return closest;
+}
+
+template <typename Real>
+QVector<QPointF> BasicTracer<Real>::trace(const QPointF& startPoint, double angle, int maxReflections) const
+{
+    QVector<QPointF> path;
+    PathCollector collector(path);
+    trace(startPoint, angle, maxReflections, collector);
+    return path;
+}
+
+template <typename Real>
+int BasicTracer<Real>::trace(const QPointF& startPoint, double angle, int maxReflections, PathSink& sink) const
+{
+    if (m_concaveWalls.isEmpty() && m_convexWalls.isEmpty()) {
+        return tracePath<false>(startPoint, angle, maxReflections, sink);
+    }
+    return tracePath<true>(startPoint, angle, maxReflections, sink);
+}
+
+template <typename Real>
+template <bool Curved>
+int BasicTracer<Real>::tracePath(const QPointF& startPoint, double angle, int maxReflections,
+                                 PathSink& sink) const
+{
+    if (!sink.addPoint(startPoint, -1)) return 0;
+
+    // Тот же шаг, что в LightRay::calculatePath, только в Real
+    Real x = Real(startPoint.x());
+    Real y = Real(startPoint.y());
+    Real directionX = std::cos(Real(angle));
+    Real directionY = std::sin(Real(angle));
+    int lastWall = -1;
+
+    int reflections = 0;
+    while (reflections < maxReflections) {
+        Real distance;
+        int wall = nextWall<Curved>(x, y, directionX, directionY, lastWall, distance);
+        if (wall < 0) break;
+
+        x = x + directionX * distance;
+        y = y + directionY * distance;
+        ++reflections;
+        if (!sink.addPoint(QPointF(double(x), double(y)), wall)) break;
+
+        Real normalX = m_normalX[wall];
+        Real normalY = m_normalY[wall];
+        if (Curved && m_flatPosition[wall] < 0) {
+            Real radialX = x - m_centerX[wall];
+            Real radialY = y - m_centerY[wall];
+            Real length = std::hypot(radialX, radialY);
+            normalX = radialX / length;
+            normalY = radialY / length;
+        }
+
+        Real projection = 2 * (directionX * normalX + directionY * normalY);
+        directionX = directionX - normalX * projection;
+        directionY = directionY - normalY * projection;
+        lastWall = wall;
+    }
+
+    return reflections;
+}
+
+template <typename Real>
+QVector<QVector<QPointF>> BasicTracer<Real>::traceFan(const QPointF& startPoint, const QVector<double>& angles,
+                                                      int maxReflections) const
+{
+    QVector<QVector<QPointF>> paths;
+    paths.reserve(angles.size());
+    for (double angle : angles) {
+        paths.append(trace(startPoint, angle, maxReflections));
+    }
+    return paths;
+}
+
+template <typename Real>
+void BasicTracer<Real>::traceFan(const QPointF& startPoint, const QVector<double>& angles, int maxReflections,
+                                 const QVector<PathSink*>& sinks) const
+{
+    for (int i = 0; i < angles.size(); ++i) {
+        trace(startPoint, angles[i], maxReflections, *sinks[i]);
+    }
+}
+
+template class BasicTracer<float>;
+template class BasicTracer<double>;
+template class BasicTracer<long double>;
@@ -0,0 +1,95 @@
+#ifndef BASICTRACER_H
+#define BASICTRACER_H
+
+#include <QPointF>
+#include <QString>
+#include <QVector>
+#include "pathsink.h"
+#include "walltable.h"
+
+// Точность, в которой идет трассировка
+class TracePrecision
+{
+public:
+    enum Kind {
+        Float,
+        Double,
+        LongDouble
+    };
+
+    static QString name(Kind kind);
+};
+
+// Трассировка линейным проходом в скалярном типе Real.
+// Стены копируются из WallTable в столбцы Real, и весь шаг луча - поиск стены,
+// точка попадания, отражение - считается в Real. Каждый тип собирается отдельно
+// (явные инстанцирования в basictracer.cpp), внутри цикла ветвлений по типу нет.
+// float вдвое расширяет векторное ядро и вдвое уменьшает трафик памяти,
+// long double дает запас точности для хаотических траекторий.
+// BasicTracer<double> побитово совпадает с LightRay без ускоряющей структуры.
+// Дуги, как в WallTable, разложены по типу зеркала, а комната без дуг идет
+// своей веткой без кода дуг.
+template <typename Real>
+class BasicTracer
+{
+public:
+    // Ядро поиска берется из table.kernel(); таблица после построения не нужна
+    explicit BasicTracer(const WallTable& table);
+
+    // Путь луча; точки округляются до double только на выходе
+    QVector<QPointF> trace(const QPointF& startPoint, double angle, int maxReflections = 50) const;
+    // То же в приемник без хранения пути, как LightRay::trace; возвращает число отражений
+    int trace(const QPointF& startPoint, double angle, int maxReflections, PathSink& sink) const;
+    QVector<QVector<QPointF>> traceFan(const QPointF& startPoint, const QVector<double>& angles,
+                                       int maxReflections = 50) const;
+    // Веер в приемники: путь луча angles[i] уходит в sinks[i]
+    void traceFan(const QPointF& startPoint, const QVector<double>& angles, int maxReflections,
+                  const QVector<PathSink*>& sinks) const;
+
+    // Ближайшая стена на неограниченном луче, как у WallTable::findNextWall
+    int findNextWall(Real originX, Real originY, Real directionX, Real directionY,
+                     int excludeWall, Real& distance) const;
+
+private:
+    WallKernel::Kind m_kernel;
+    Real m_minHitDistance;
+
+    // Плоские стены подряд, дополненные нулями до кратного WallKernel::MaxFloatLanes;
+    // m_flatWalls[k] - номер стены в таблице
+    QVector<int> m_flatWalls;
+    QVector<Real> m_startX;
+    QVector<Real> m_startY;
+    QVector<Real> m_directionX;
+    QVector<Real> m_directionY;
+    QVector<Real> m_inverseLength;
+
+    // По номеру стены: нормаль хорды, место в плоских столбцах (-1 у дуги) и данные дуги
+    QVector<Real> m_normalX;
+    QVector<Real> m_normalY;
+    QVector<int> m_flatPosition;
+    QVector<int> m_concaveWalls;
+    QVector<int> m_convexWalls;
+    QVector<Real> m_arcStartX;
+    QVector<Real> m_arcStartY;
+    QVector<Real> m_centerX;
+    QVector<Real> m_centerY;
+    QVector<Real> m_curvatureRadius;
+
+    template <bool Curved>
+    int tracePath(const QPointF& startPoint, double angle, int maxReflections, PathSink& sink) const;
+    template <bool Curved>
+    int nextWall(Real originX, Real originY, Real directionX, Real directionY,
+                 int excludeWall, Real& distance) const;
+    template <WallTable::Surface S>
+    bool intersectArc(int i, Real originX, Real originY, Real directionX, Real directionY,
+                      bool farOnly, Real& t) const;
+    template <WallTable::Surface S>
+    void nearestArc(const QVector<int>& walls, Real originX, Real originY, Real directionX, Real directionY,
+                    int excludeWall, int& closest, Real& distance) const;
+};
+
+extern template class BasicTracer<float>;
+extern template class BasicTracer<double>;
+extern template class BasicTracer<long double>;
+
+#endif // BASICTRACER_H
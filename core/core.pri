@@ -0,0 +1,15 @@
+# Links a project against the tracing core library.
+# Include from any subproject that needs Wall/LightRay: include(../core/core.pri)
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../core/release/ -lmirrorcore
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/../core/debug/ -lmirrorcore
+else:unix: LIBS += -L$$OUT_PWD/../core/ -lmirrorcore
+
+win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/release/libmirrorcore.a
+else:win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/debug/libmirrorcore.a
+else:win32:!win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/release/mirrorcore.lib
+else:win32:!win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/debug/mirrorcore.lib
+else:unix: PRE_TARGETDEPS += $$OUT_PWD/../core/libmirrorcore.a
@@ -0,0 +1,50 @@
+QT = core
+
+TEMPLATE = lib
+CONFIG += staticlib c++17
+
+TARGET = mirrorcore
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+# Скалярное и SIMD-ядра должны давать одинаковые попадания:
+# запрещаем компилятору сливать умножение и сложение в FMA
+contains(QMAKE_COMPILER, gcc): QMAKE_CXXFLAGS += -ffp-contract=off
+
+SOURCES += \
+    anglesweep.cpp \
+    basictracer.cpp \
+    lightray.cpp \
+    longtrace.cpp \
+    orbittracer.cpp \
+    packettracer.cpp \
+    pathsink.cpp \
+    roombuilder.cpp \
+    roomfile.cpp \
+    tracecache.cpp \
+    wall.cpp \
+    wallbvh.cpp \
+    wallgrid.cpp \
+    wallindex.cpp \
+    wallkernel.cpp \
+    walltable.cpp
+
+HEADERS += \
+    anglesweep.h \
+    basictracer.h \
+    lightray.h \
+    longtrace.h \
+    orbittracer.h \
+    packettracer.h \
+    pathsink.h \
+    roombuilder.h \
+    roomfile.h \
+    tracecache.h \
+    wall.h \
+    wallbvh.h \
+    wallgrid.h \
+    wallindex.h \
+    wallkernel.h \
+    walltable.h
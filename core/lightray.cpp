@@ -0,0 +1,280 @@
+#include "lightray.h"
+#include <QElapsedTimer>
+#include <cmath>
+#include <limits>
+
+const double LightRay::RayLength = std::numeric_limits<double>::infinity();
+
+namespace {
+
+// Наименьший кусок ленивой трассировки
+const int ChunkReflections = 4096;
+// Отражений между сохраненными состояниями: после правки стены или меньшего предела
+// пересчитывается не больше стольких отражений сверх нужного
+const int CheckpointReflections = 1024;
+
+// Путь вместе со стенами отражений
+class WallPathCollector : public PathSink
+{
+public:
+    WallPathCollector(QVector<QPointF>& path, QVector<int>& walls) : m_path(&path), m_walls(&walls) {}
+
+    bool addPoint(const QPointF& point, int wall) override
+    {
+        m_path->append(point);
+        m_walls->append(wall);
+        return true;
+    }
+
+private:
+    QVector<QPointF>* m_path;
+    QVector<int>* m_walls;
+};
+
+}
+
+LightRay::LightRay(const QPointF& startPoint, double startAngle, const WallTable& table,
+                   const WallIndex* index, int maxReflections)
+    : m_startPoint(startPoint)
+    , m_startAngle(startAngle)
+    , m_table(&table)
+    , m_index(index)
+    , m_maxReflections(qMax(0, maxReflections))
+    , m_state(startState(startPoint, startAngle))
+    , m_reflections(0)
+    , m_escaped(false)
+    , m_minHitDistance(0.0)
+{
+    resetPath();
+}
+
+void LightRay::calculatePath(int maxReflections)
+{
+    m_maxReflections = qMax(0, maxReflections);
+    resetPath();
+    path();
+}
+
+void LightRay::setStart(const QPointF& startPoint, double startAngle)
+{
+    m_startPoint = startPoint;
+    m_startAngle = startAngle;
+    resetPath();
+}
+
+void LightRay::setMaxReflections(int maxReflections)
+{
+    maxReflections = qMax(0, maxReflections);
+    truncatePath(maxReflections);
+    m_maxReflections = maxReflections;
+}
+
+void LightRay::wallChanged(int wall)
+{
+    if (m_table->minHitDistance() != m_minHitDistance) {
+        resetPath();
+        return;
+    }
+
+    // Первый отрезок, на который влияет стена: он кончается на ней или пересекает ее новую форму.
+    // Направление отрезка восстанавливается по точкам; запас minHitDistance покрывает его округление
+    const double margin = m_minHitDistance;
+    for (int i = 0; i < m_reflections; ++i) {
+        QPointF delta = m_path[i + 1] - m_path[i];
+        double length = std::hypot(delta.x(), delta.y());
+        double t;
+        if (m_pathWalls[i + 1] == wall
+            || (length > 0.0 && m_table->hitWall(wall, m_path[i].x(), m_path[i].y(), delta.x() / length,
+                                                 delta.y() / length, 0.0, length + margin, m_pathWalls[i], t))) {
+            truncatePath(i);
+            m_escaped = false;
+            return;
+        }
+    }
+
+    // Ушедший луч стена теперь может поймать: продолжаем с последнего состояния, оно не изменилось
+    m_escaped = false;
+}
+
+const QVector<QPointF>& LightRay::path() const
+{
+    tracePath(m_maxReflections);
+    return m_path;
+}
+
+const QVector<QPointF>& LightRay::path(int reflections) const
+{
+    if (reflections > m_reflections) {
+        // Кусок не меньше ChunkReflections: частые короткие запросы не дробят трассировку
+        tracePath(qMax(reflections, m_reflections + ChunkReflections));
+    }
+    return m_path;
+}
+
+int LightRay::traceFor(qint64 nanoseconds, int step)
+{
+    QElapsedTimer timer;
+    timer.start();
+    int before = m_reflections;
+    while (!complete() && timer.nsecsElapsed() < nanoseconds) {
+        tracePath(m_reflections + qMax(1, step));
+    }
+    return m_reflections - before;
+}
+
+LightRay::Tail LightRay::tail(int from) const
+{
+    from = qBound(0, from, m_reflections);
+    int firstCheckpoint = from / CheckpointReflections + 1;
+    return Tail{from, m_path.mid(from + 1), m_pathWalls.mid(from + 1),
+                m_checkpoints.mid(qMin(firstCheckpoint, m_checkpoints.size())), m_state, m_escaped};
+}
+
+bool LightRay::appendTail(const Tail& tail)
+{
+    if (tail.from != m_reflections) return false;
+
+    m_path += tail.points;
+    m_pathWalls += tail.walls;
+    m_checkpoints += tail.checkpoints;
+    m_state = tail.state;
+    m_reflections += tail.points.size();
+    m_escaped = tail.escaped;
+    return true;
+}
+
+void LightRay::resetPath()
+{
+    m_path.clear();
+    m_path.append(m_startPoint);
+    m_pathWalls.clear();
+    m_pathWalls.append(-1);
+    m_state = startState(m_startPoint, m_startAngle);
+    m_reflections = 0;
+    m_escaped = false;
+    m_checkpoints.clear();
+    m_checkpoints.append(m_state);
+    m_minHitDistance = m_table->minHitDistance();
+}
+
+void LightRay::truncatePath(int reflections)
+{
+    if (reflections >= m_reflections) return;
+
+    int checkpoint = qMax(0, reflections) / CheckpointReflections;
+    int kept = checkpoint * CheckpointReflections;
+    m_path.resize(kept + 1);
+    m_pathWalls.resize(kept + 1);
+    m_checkpoints.resize(checkpoint + 1);
+    m_state = m_checkpoints[checkpoint];
+    m_reflections = kept;
+    m_escaped = false;
+}
+
+void LightRay::tracePath(int reflections) const
+{
+    reflections = qMin(reflections, m_maxReflections);
+    if (m_escaped || reflections <= m_reflections) return;
+
+    m_path.reserve(reflections + 1);
+    m_pathWalls.reserve(reflections + 1);
+    WallPathCollector collector(m_path, m_pathWalls);
+
+    // Продолжение с m_state делает тот же шаг, что и трассировка за один раз: путь совпадает побитово.
+    // Куски кончаются на границах CheckpointReflections, чтобы сохранить там состояние
+    while (m_reflections < reflections) {
+        int next = qMin(reflections, (m_reflections / CheckpointReflections + 1) * CheckpointReflections);
+        int count = next - m_reflections;
+        int done = advance(m_state, *m_table, m_index, count, collector);
+        m_reflections += done;
+        if (done < count) {
+            m_escaped = true;
+            return;
+        }
+        if (m_reflections % CheckpointReflections == 0) m_checkpoints.append(m_state);
+    }
+}
+
+int LightRay::trace(const QPointF& startPoint, double startAngle, const WallTable& table,
+                    const WallIndex* index, int maxReflections, PathSink& sink)
+{
+    if (!sink.addPoint(startPoint, -1)) return 0;
+
+    State state = startState(startPoint, startAngle);
+    return advance(state, table, index, maxReflections, sink);
+}
+
+LightRay::State LightRay::startState(const QPointF& startPoint, double startAngle)
+{
+    return State{startPoint, directionForAngle(startAngle), -1};
+}
+
+int LightRay::advance(State& state, const WallTable& table, const WallIndex* index,
+                      int maxReflections, PathSink& sink)
+{
+    return table.hasArcs() ? advancePath<true>(state, table, index, maxReflections, sink)
+                           : advancePath<false>(state, table, index, maxReflections, sink);
+}
+
+template <bool Curved>
+int LightRay::advancePath(State& state, const WallTable& table, const WallIndex* index,
+                          int maxReflections, PathSink& sink)
+{
+    // Локальные копии: компилятор держит их в регистрах, state пишется один раз в конце
+    QPointF currentPoint = state.position;
+    QPointF direction = state.direction;
+    int lastWall = state.lastWall;
+
+    int reflections = 0;
+    while (reflections < maxReflections) {
+        QPointF intersection;
+        int nextWall = findNextWall<Curved>(table, index, currentPoint, direction, lastWall, intersection);
+
+        if (nextWall < 0) break;
+
+        ++reflections;
+        currentPoint = intersection;
+        direction = reflectedDirection<Curved>(table, nextWall, intersection, direction);
+        lastWall = nextWall;
+        if (!sink.addPoint(intersection, nextWall)) break;
+    }
+
+    state = State{currentPoint, direction, lastWall};
+    return reflections;
+}
+
+template <bool Curved>
+int LightRay::findNextWall(const WallTable& table, const WallIndex* index, const QPointF& currentPoint,
+                           const QPointF& direction, int lastWall, QPointF& intersection)
+{
+    // Стену, от которой луч отразился, исключаем по индексу: ограничение на длину шага
+    // теряло бы настоящие попадания в узких углах
+    double distance;
+    double minDistance = table.minHitDistance();
+    int wall;
+    if (index) {
+        wall = index->findNextWall(currentPoint, direction, RayLength, minDistance, lastWall, distance);
+    } else if (Curved) {
+        wall = table.findNextWall(currentPoint, direction, RayLength, minDistance, lastWall, distance);
+    } else {
+        wall = table.findNextFlatWall(currentPoint, direction, RayLength, minDistance, lastWall, distance);
+    }
+
+    if (wall >= 0) {
+        intersection = currentPoint + direction * distance;
+    }
+    return wall;
+}
+
+QPointF LightRay::directionForAngle(double angle)
+{
+    // angle в радианах, 0 - вправо, увеличение против часовой стрелки
+    return QPointF(cos(angle), sin(angle));
+}
+
+QPointF LightRay::reflectedDirection(const WallTable& table, int wall, const QPointF& point,
+                                     const QPointF& direction)
+{
+    // Нормаль единичная, поэтому длина направления сохраняется с точностью округления
+    return reflectedDirection<true>(table, wall, point, direction);
+}
@@ -0,0 +1,159 @@
+#ifndef LIGHTRAY_H
+#define LIGHTRAY_H
+
+#include <QPointF>
+#include <QVector>
+#include "pathsink.h"
+#include "walltable.h"
+#include "wallindex.h"
+
+class LightRay
+{
+public:
+    // table - таблица стен комнаты, должна жить дольше луча.
+    // index - необязательная ускоряющая структура над той же таблицей;
+    // без нее стены перебираются линейно. Путь до maxReflections отражений
+    // строится лениво, кусками, когда его читают (path(), path(reflections))
+    LightRay(const QPointF& startPoint, double startAngle, const WallTable& table,
+             const WallIndex* index = nullptr, int maxReflections = 50);
+
+    // Трассировка без хранения пути: точки уходят в sink по мере отражений.
+    // Возвращает число выполненных отражений
+    static int trace(const QPointF& startPoint, double startAngle, const WallTable& table,
+                     const WallIndex* index, int maxReflections, PathSink& sink);
+
+    // Все, что нужно для продолжения луча: точка, единичное направление
+    // и стена последнего отражения (-1 в начале пути)
+    struct State {
+        QPointF position;
+        QPointF direction;
+        int lastWall;
+    };
+    static State startState(const QPointF& startPoint, double startAngle);
+    // Продолжает луч из state до maxReflections отражений; state сдвигается вместе с лучом.
+    // В sink идут только точки отражения. Меньше maxReflections - луч ушел из комнаты
+    // или sink попросил остановиться
+    static int advance(State& state, const WallTable& table, const WallIndex* index,
+                       int maxReflections, PathSink& sink);
+
+    // Путь заново от точки старта, сразу целиком
+    void calculatePath(int maxReflections = 50);
+    // Новый старт: путь лениво считается заново, память под путь остается.
+    // Так предпросмотр переиспользует один луч на каждое движение мыши
+    void setStart(const QPointF& startPoint, double startAngle);
+    // Новый предел отражений. Больший продолжает путь с последнего отражения -
+    // считаются только новые отражения, и только когда их прочитают.
+    // Меньший обрезает путь до ближайшего сохраненного состояния
+    void setMaxReflections(int maxReflections);
+    int maxReflections() const { return m_maxReflections; }
+
+    // Весь путь до maxReflections отражений; досчитывает недостающее
+    const QVector<QPointF>& path() const;
+    // Путь, в котором посчитано не меньше min(reflections, maxReflections) отражений
+    // (если луч не ушел раньше); считает кусками, поэтому точек может быть больше.
+    // Так рендерер получает первые отражения, не дожидаясь всего пути
+    const QVector<QPointF>& path(int reflections) const;
+    // Досчитывает путь шагами по step отражений, пока не истечет nanoseconds или путь не кончится;
+    // возвращает число новых отражений. Так первый кадр предпросмотра укладывается в бюджет
+    int traceFor(qint64 nanoseconds, int step = 16);
+    // Уже посчитанная часть пути, без досчета: так путь читают, пока его считает другой поток
+    const QVector<QPointF>& tracedPath() const { return m_path; }
+    // Стены отражений, параллельно path(): -1 у точки старта
+    const QVector<int>& pathWalls() const { return m_pathWalls; }
+    // Сколько отражений уже посчитано
+    int reflections() const { return m_reflections; }
+    // Путь посчитан до предела или луч ушел из комнаты
+    bool complete() const { return m_escaped || m_reflections >= m_maxReflections; }
+    // Луч ушел из комнаты: продолжать путь нечем
+    bool escaped() const { return m_escaped; }
+    // Другая ускоряющая структура над той же таблицей: пути от нее не зависят,
+    // поэтому посчитанная часть сохраняется
+    void setWallIndex(const WallIndex* index) { m_index = index; }
+    // Другая таблица с тем же содержимым, например копия в потоке трассировки
+    void setWallTable(const WallTable& table) { m_table = &table; }
+
+    // Продолжение пути после отражения from: новые точки со стенами, сохраненные
+    // состояния и состояние в конце. Так путь, посчитанный копией луча в другом потоке,
+    // переносится в луч без пересчета
+    struct Tail {
+        int from;
+        QVector<QPointF> points;
+        QVector<int> walls;
+        QVector<State> checkpoints;
+        State state;
+        bool escaped;
+    };
+    Tail tail(int from) const;
+    // false, если хвост начинается не с последнего посчитанного отражения
+    bool appendTail(const Tail& tail);
+
+    // Таблица перестроена после правки стены wall (тип зеркала, радиус).
+    // Начало пути до первого отрезка, который кончается на этой стене или пересекает
+    // ее новую форму, остается; дальше путь досчитывается лениво от ближайшего
+    // сохраненного состояния. Если правка изменила порог minHitDistance() таблицы,
+    // путь считается заново целиком
+    void wallChanged(int wall);
+    // Таблица перестроена целиком: путь считается заново от старта
+    void invalidatePath() { resetPath(); }
+    QPointF startPoint() const { return m_startPoint; }
+    double startAngle() const { return m_startAngle; }
+
+    // Правила шага трассировки, общие с PacketTracer, чтобы пути совпадали.
+    // Внутри луч несет направление единичным вектором; угол - только на границе API.
+    // Луч не ограничен по длине; стена, от которой он отразился, исключается из следующего поиска
+    static const double RayLength;
+    static QPointF directionForAngle(double angle);
+    // Отражение d - 2(d·n)n от стены wall в точке point, без тригонометрии;
+    // у дуги нормаль берется в точке попадания
+    static QPointF reflectedDirection(const WallTable& table, int wall, const QPointF& point,
+                                      const QPointF& direction);
+    // То же с типом комнаты, известным при компиляции: без дуг (Curved == false)
+    // нормаль берется из таблицы без проверки типа стены
+    template <bool Curved>
+    static QPointF reflectedDirection(const WallTable& table, int wall, const QPointF& point,
+                                      const QPointF& direction);
+
+private:
+    QPointF m_startPoint;
+    double m_startAngle;
+    const WallTable* m_table;
+    const WallIndex* m_index;
+    int m_maxReflections;
+    // Ленивый путь: досчитывается из константных path(), поэтому mutable.
+    // Луч не разделяется между потоками - блокировки нет
+    mutable QVector<QPointF> m_path;
+    mutable QVector<int> m_pathWalls;
+    // Состояние после последнего посчитанного отражения - отсюда путь продолжается
+    mutable State m_state;
+    mutable int m_reflections;
+    mutable bool m_escaped;
+    // Состояния после каждых CheckpointReflections отражений (первое - старт):
+    // с них путь продолжается после обрезки
+    mutable QVector<State> m_checkpoints;
+    // Порог таблицы, с которым посчитан путь
+    double m_minHitDistance;
+
+    void resetPath();
+    // Оставляет не больше reflections отражений, обрезая до сохраненного состояния
+    void truncatePath(int reflections);
+    void tracePath(int reflections) const;
+
+    // Луч идет веткой, выбранной один раз по WallTable::hasArcs()
+    template <bool Curved>
+    static int advancePath(State& state, const WallTable& table, const WallIndex* index,
+                           int maxReflections, PathSink& sink);
+    template <bool Curved>
+    static int findNextWall(const WallTable& table, const WallIndex* index, const QPointF& currentPoint,
+                            const QPointF& direction, int lastWall, QPointF& intersection);
+};
+
+template <bool Curved>
+inline QPointF LightRay::reflectedDirection(const WallTable& table, int wall, const QPointF& point,
+                                            const QPointF& direction)
+{
+    QPointF normal = Curved ? table.normalAt(wall, point) : table.normal(wall);
+    double projection = direction.x() * normal.x() + direction.y() * normal.y();
+    return direction - 2 * projection * normal;
+}
+
+#endif // LIGHTRAY_H
@@ -0,0 +1,245 @@
+#include "longtrace.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QStringList>
+#include <QTextStream>
+#include <limits>
+
+namespace {
+
+// Отмена проверяется между блоками: 2^16 отражений - доли секунды даже на большой комнате
+const qint64 BlockReflections = 1 << 16;
+
+// Передает точки приемнику пользователя и запоминает, что он попросил остановиться
+class ForwardSink : public PathSink
+{
+public:
+    explicit ForwardSink(PathSink* sink) : m_sink(sink), m_stopped(false) {}
+
+    bool addPoint(const QPointF& point, int wall) override
+    {
+        if (m_sink && !m_sink->addPoint(point, wall)) m_stopped = true;
+        return !m_stopped;
+    }
+
+    bool stopped() const { return m_stopped; }
+
+private:
+    PathSink* m_sink;
+    bool m_stopped;
+};
+
+// Следующая после done граница, кратная interval; без интервала - никогда
+qint64 nextMultiple(qint64 done, qint64 interval)
+{
+    if (interval <= 0) return std::numeric_limits<qint64>::max();
+    return (done / interval + 1) * interval;
+}
+
+}
+
+LongTrace::LongTrace(const WallTable& table, const WallIndex* index)
+    : m_table(&table)
+    , m_index(index)
+    , m_roomHash(table.hash())
+    , m_state(LightRay::startState(QPointF(), 0.0))
+    , m_reflections(0)
+    , m_checkpointInterval(0)
+    , m_progressInterval(0)
+    , m_outputSize(-1)
+{
+}
+
+void LongTrace::start(const QPointF& startPoint, double startAngle)
+{
+    m_state = LightRay::startState(startPoint, startAngle);
+    m_reflections = 0;
+    m_outputSize = -1;
+}
+
+bool LongTrace::resume(const QString& filename, QString* errorMessage)
+{
+    Checkpoint checkpoint;
+    if (!loadCheckpoint(filename, checkpoint, errorMessage)) return false;
+
+    if (checkpoint.roomHash != m_roomHash) {
+        if (errorMessage) *errorMessage = QString("%1: checkpoint was written for a different room").arg(filename);
+        return false;
+    }
+    // Хэш совпал, но номер стены все равно индексирует столбцы таблицы - проверяем и его
+    if (checkpoint.state.lastWall >= m_table->size()) {
+        if (errorMessage) *errorMessage = QString("%1: malformed checkpoint").arg(filename);
+        return false;
+    }
+
+    m_state = checkpoint.state;
+    m_reflections = checkpoint.reflections;
+    m_outputSize = checkpoint.outputSize;
+    return true;
+}
+
+void LongTrace::setCheckpointFile(const QString& filename, qint64 interval)
+{
+    m_checkpointFile = filename;
+    m_checkpointInterval = interval;
+}
+
+void LongTrace::setProgress(const ProgressFunction& progress, qint64 interval)
+{
+    m_progress = progress;
+    m_progressInterval = interval;
+}
+
+LongTrace::Status LongTrace::run(qint64 totalReflections, PathSink* sink, QString* errorMessage)
+{
+    m_cancelled.storeRelease(0);
+
+    ForwardSink forward(sink);
+    const bool checkpoints = !m_checkpointFile.isEmpty();
+    qint64 nextCheckpoint = nextMultiple(m_reflections, checkpoints ? m_checkpointInterval : 0);
+    qint64 nextProgress = nextMultiple(m_reflections, m_progress ? m_progressInterval : 0);
+    qint64 savedReflections = -1;
+    qint64 reportedReflections = -1;
+
+    Status status = Finished;
+    while (m_reflections < totalReflections) {
+        if (m_cancelled.loadAcquire()) {
+            status = Stopped;
+            break;
+        }
+
+        // Блок заканчивается на ближайшей границе, чтобы контрольная точка легла ровно на нее
+        qint64 blockEnd = qMin(qMin(totalReflections, m_reflections + BlockReflections),
+                               qMin(nextCheckpoint, nextProgress));
+        int count = int(blockEnd - m_reflections);
+        int done = LightRay::advance(m_state, *m_table, m_index, count, forward);
+        m_reflections += done;
+
+        if (m_reflections >= nextCheckpoint) {
+            if (!writeCheckpoint(errorMessage)) return Failed;
+            savedReflections = m_reflections;
+            nextCheckpoint = nextMultiple(m_reflections, m_checkpointInterval);
+        }
+        if (m_reflections >= nextProgress) {
+            m_progress(m_reflections);
+            reportedReflections = m_reflections;
+            nextProgress = nextMultiple(m_reflections, m_progressInterval);
+        }
+
+        if (done < count) {
+            status = forward.stopped() ? Stopped : Escaped;
+            break;
+        }
+    }
+
+    // Последнее состояние сохраняется всегда, чтобы остановленный прогон можно было продолжить
+    if (checkpoints && savedReflections != m_reflections && !writeCheckpoint(errorMessage)) return Failed;
+    if (m_progress && reportedReflections != m_reflections) m_progress(m_reflections);
+    return status;
+}
+
+bool LongTrace::writeCheckpoint(QString* errorMessage) const
+{
+    // Сначала вывод: точка не должна ссылаться на строки, которые еще в буфере
+    qint64 outputSize = -1;
+    if (m_flush && !m_flush(outputSize)) {
+        if (errorMessage) *errorMessage = "failed to write the output";
+        return false;
+    }
+    return saveCheckpoint(m_checkpointFile, Checkpoint{m_roomHash, m_reflections, m_state, outputSize},
+                          errorMessage);
+}
+
+bool LongTrace::saveCheckpoint(const QString& filename, const Checkpoint& checkpoint, QString* errorMessage)
+{
+    // QSaveFile подменяет файл целиком при commit(): сбой во время записи
+    // оставляет предыдущую контрольную точку нетронутой
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        if (errorMessage) *errorMessage = file.errorString();
+        return false;
+    }
+
+    {
+        // 17 значащих цифр восстанавливают double без потерь
+        QTextStream out(&file);
+        out.setRealNumberPrecision(17);
+        out << "# mirrortrace checkpoint\n";
+        out << "room " << checkpoint.roomHash.toHex() << '\n';
+        out << "reflections " << checkpoint.reflections << '\n';
+        out << "position " << checkpoint.state.position.x() << ' ' << checkpoint.state.position.y() << '\n';
+        out << "direction " << checkpoint.state.direction.x() << ' ' << checkpoint.state.direction.y() << '\n';
+        out << "wall " << checkpoint.state.lastWall << '\n';
+        if (checkpoint.outputSize >= 0) {
+            out << "output " << checkpoint.outputSize << '\n';
+        }
+    }
+
+    if (!file.commit()) {
+        if (errorMessage) *errorMessage = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool LongTrace::loadCheckpoint(const QString& filename, Checkpoint& checkpoint, QString* errorMessage)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        if (errorMessage) *errorMessage = file.errorString();
+        return false;
+    }
+
+    // Каждое поле не больше одного раза, порядок любой; все, кроме output, обязательны
+    const QStringList keys = {"room", "reflections", "position", "direction", "wall", "output"};
+    const int required = (1 << 5) - 1;
+    Checkpoint loaded;
+    int seen = 0;
+    bool ok = true;
+    QTextStream in(&file);
+
+    while (ok && !in.atEnd()) {
+        QString line = in.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) continue;
+
+        QStringList fields = line.split(' ', Qt::SkipEmptyParts);
+        QString key = fields.takeFirst();
+        int field = keys.indexOf(key);
+        ok = field >= 0 && !(seen & (1 << field));
+        if (!ok) break;
+        seen |= 1 << field;
+
+        bool okX = false;
+        bool okY = false;
+
+        if (key == "room" && fields.size() == 1) {
+            loaded.roomHash = QByteArray::fromHex(fields[0].toLatin1());
+            ok = !loaded.roomHash.isEmpty();
+        } else if (key == "reflections" && fields.size() == 1) {
+            loaded.reflections = fields[0].toLongLong(&ok);
+            ok = ok && loaded.reflections >= 0;
+        } else if (key == "position" && fields.size() == 2) {
+            loaded.state.position = QPointF(fields[0].toDouble(&okX), fields[1].toDouble(&okY));
+            ok = okX && okY;
+        } else if (key == "direction" && fields.size() == 2) {
+            loaded.state.direction = QPointF(fields[0].toDouble(&okX), fields[1].toDouble(&okY));
+            ok = okX && okY;
+        } else if (key == "wall" && fields.size() == 1) {
+            loaded.state.lastWall = fields[0].toInt(&ok);
+            ok = ok && loaded.state.lastWall >= -1;
+        } else if (key == "output" && fields.size() == 1) {
+            loaded.outputSize = fields[0].toLongLong(&ok);
+            ok = ok && loaded.outputSize >= 0;
+        } else {
+            ok = false;
+        }
+    }
+
+    if (!ok || (seen & required) != required) {
+        if (errorMessage) *errorMessage = QString("%1: malformed checkpoint").arg(filename);
+        return false;
+    }
+
+    checkpoint = loaded;
+    return true;
+}
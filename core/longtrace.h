@@ -0,0 +1,93 @@
+#ifndef LONGTRACE_H
+#define LONGTRACE_H
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QString>
+#include <functional>
+#include "lightray.h"
+#include "pathsink.h"
+#include "walltable.h"
+#include "wallindex.h"
+
+// Длинная трассировка одного луча - 10^9 отражений и больше - с постоянной памятью.
+// Хранится только LightRay::State и счетчик отражений, путь уходит в приемник, если он задан.
+// Каждые checkpointInterval отражений состояние пишется в файл контрольной точки
+// вместе с хэшем комнаты; с этого файла трассировку можно продолжить после остановки
+// или сбоя, и продолжение побитово совпадает с непрерывным прогоном.
+// run() идет блоками: между блоками сообщается прогресс и проверяется отмена.
+class LongTrace
+{
+public:
+    enum Status {
+        Finished,   // сделано заданное число отражений
+        Escaped,    // луч ушел из комнаты
+        Stopped,    // остановлен cancel() или приемником
+        Failed      // не удалось записать контрольную точку
+    };
+
+    // Состояние в файле контрольной точки
+    struct Checkpoint {
+        QByteArray roomHash;
+        qint64 reflections;
+        LightRay::State state;
+        qint64 outputSize = -1;     // байт вывода, записанных к этой точке; -1 - не известно
+    };
+
+    typedef std::function<void(qint64 reflections)> ProgressFunction;
+    // Сбрасывает буферы вывода приемника и сообщает его размер в байтах (-1, если вывод
+    // не файл); false - вывод не записался, контрольная точка не пишется
+    typedef std::function<bool(qint64& outputSize)> FlushFunction;
+
+    // table и index - как у LightRay, должны жить дольше трассировки
+    LongTrace(const WallTable& table, const WallIndex* index = nullptr);
+
+    // Новый луч; отражения считаются с нуля
+    void start(const QPointF& startPoint, double startAngle);
+    // Продолжение с контрольной точки; false, если файл не читается или комната другая
+    bool resume(const QString& filename, QString* errorMessage = nullptr);
+
+    qint64 reflections() const { return m_reflections; }
+    const LightRay::State& state() const { return m_state; }
+    // Размер вывода из контрольной точки resume(): до него вывод надо обрезать перед
+    // дописыванием, иначе строки после точки повторятся. -1 - в точке не записан
+    qint64 outputSize() const { return m_outputSize; }
+
+    // Пустое имя файла - без контрольных точек
+    void setCheckpointFile(const QString& filename, qint64 interval);
+    // progress вызывается примерно каждые interval отражений и в конце run()
+    void setProgress(const ProgressFunction& progress, qint64 interval);
+    // flush вызывается перед каждой контрольной точкой: в точке - только сброшенный вывод
+    void setOutputFlush(const FlushFunction& flush) { m_flush = flush; }
+
+    // Можно вызывать из другого потока или обработчика сигнала:
+    // run() остановится на границе блока и запишет контрольную точку
+    void cancel() { m_cancelled.storeRelease(1); }
+
+    // Трассирует, пока общее число отражений не дойдет до totalReflections.
+    // sink получает только точки отражения, может быть nullptr
+    Status run(qint64 totalReflections, PathSink* sink = nullptr, QString* errorMessage = nullptr);
+
+    static bool saveCheckpoint(const QString& filename, const Checkpoint& checkpoint,
+                               QString* errorMessage = nullptr);
+    static bool loadCheckpoint(const QString& filename, Checkpoint& checkpoint,
+                               QString* errorMessage = nullptr);
+
+private:
+    const WallTable* m_table;
+    const WallIndex* m_index;
+    QByteArray m_roomHash;
+    LightRay::State m_state;
+    qint64 m_reflections;
+    QString m_checkpointFile;
+    qint64 m_checkpointInterval;
+    ProgressFunction m_progress;
+    qint64 m_progressInterval;
+    FlushFunction m_flush;
+    qint64 m_outputSize;
+    QAtomicInt m_cancelled;
+
+    bool writeCheckpoint(QString* errorMessage) const;
+};
+
+#endif // LONGTRACE_H
@@ -0,0 +1,93 @@
+#include "orbittracer.h"
+#include <cmath>
+
+const double OrbitTracer::DefaultTolerance = 1e-9;
+
+namespace {
+
+// Повторный проход ищет только начало орбиты, точки уже отданы
+class NullSink : public PathSink
+{
+public:
+    bool addPoint(const QPointF&, int) override { return true; }
+};
+
+}
+
+OrbitTracer::OrbitTracer(const WallTable& table, const WallIndex* index, double tolerance)
+    : m_table(&table)
+    , m_index(index)
+    , m_tolerance(tolerance)
+{
+}
+
+OrbitTracer::Key OrbitTracer::key(const LightRay::State& state) const
+{
+    int wall = state.lastWall;
+    QPointF offset = state.position - m_table->startPoint(wall);
+    QPointF along = m_table->direction(wall);
+    double position = (offset.x() * along.x() + offset.y() * along.y()) * m_table->inverseLength(wall);
+    return Key{wall, position, state.direction.x(), state.direction.y()};
+}
+
+bool OrbitTracer::matches(const Key& a, const Key& b) const
+{
+    return a.wall == b.wall && std::abs(a.position - b.position) <= m_tolerance
+           && std::abs(a.directionX - b.directionX) <= m_tolerance
+           && std::abs(a.directionY - b.directionY) <= m_tolerance;
+}
+
+Orbit OrbitTracer::trace(const QPointF& startPoint, double startAngle, int maxReflections, PathSink& sink) const
+{
+    Orbit orbit = {0, 0, QPointF()};
+    if (!sink.addPoint(startPoint, -1)) return orbit;
+
+    // Брент: черепаха стоит на отражениях 1, 2, 4, 8..., заяц идет по одному.
+    // Когда заяц совпадет с черепахой, расстояние между ними - период
+    LightRay::State hare = LightRay::startState(startPoint, startAngle);
+    if (maxReflections < 1 || LightRay::advance(hare, *m_table, m_index, 1, sink) < 1) return orbit;
+    Key tortoise = key(hare);
+    if (maxReflections < 2 || LightRay::advance(hare, *m_table, m_index, 1, sink) < 1) return orbit;
+
+    int reflections = 2;
+    int power = 1;
+    int period = 1;
+    while (!matches(tortoise, key(hare))) {
+        if (power == period) {
+            tortoise = key(hare);
+            power *= 2;
+            period = 0;
+        }
+        if (reflections >= maxReflections || LightRay::advance(hare, *m_table, m_index, 1, sink) < 1) {
+            return orbit;
+        }
+        ++reflections;
+        ++period;
+    }
+
+    // Начало орбиты: второй луч впереди на period отражений, оба идут до первого совпадения.
+    // Путь детерминирован, поэтому совпадение найдется не позже места, где его нашел Брент
+    NullSink none;
+    LightRay::State first = LightRay::startState(startPoint, startAngle);
+    LightRay::advance(first, *m_table, m_index, 1, none);
+    LightRay::State second = first;
+    LightRay::advance(second, *m_table, m_index, period, none);
+
+    int start = 1;
+    while (!matches(key(first), key(second)) && start < reflections) {
+        LightRay::advance(first, *m_table, m_index, 1, none);
+        LightRay::advance(second, *m_table, m_index, 1, none);
+        ++start;
+    }
+
+    orbit.period = period;
+    orbit.start = start;
+    orbit.point = first.position;
+    return orbit;
+}
+
+Orbit OrbitTracer::findOrbit(const QPointF& startPoint, double startAngle, int maxReflections) const
+{
+    NullSink none;
+    return trace(startPoint, startAngle, maxReflections, none);
+}
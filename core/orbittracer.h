@@ -0,0 +1,59 @@
+#ifndef ORBITTRACER_H
+#define ORBITTRACER_H
+
+#include <QPointF>
+#include "lightray.h"
+#include "pathsink.h"
+#include "walltable.h"
+#include "wallindex.h"
+
+// Периодическая орбита луча: начиная с отражения start путь повторяется через period отражений
+struct Orbit {
+    int period;     // 0 - орбита не найдена за maxReflections или луч ушел из комнаты
+    int start;      // номер первого отражения орбиты (1 - первое отражение луча)
+    QPointF point;  // точка этого отражения
+};
+
+// Трассировка с ранней остановкой на периодической орбите.
+// Состояние после отражения - стена, положение точки на стене (0..1 вдоль хорды)
+// и направление; два состояния совпадают, если стена та же, а положение и компоненты
+// направления отличаются не больше tolerance. Цикл ищется алгоритмом Брента:
+// память постоянная (два состояния луча), период находится за O(start + period) шагов,
+// начало орбиты - повторным проходом от старта без записи пути.
+// Нужен допуск, а не точное равенство: на периодической орбите в многоугольнике
+// ошибка округления не затухает, и точка возвращается лишь примерно в себя.
+class OrbitTracer
+{
+public:
+    // Допуск по умолчанию - далеко над округлением за миллионы отражений
+    static const double DefaultTolerance;
+
+    // table и index - как у LightRay, должны жить дольше трассировщика
+    OrbitTracer(const WallTable& table, const WallIndex* index = nullptr,
+                double tolerance = DefaultTolerance);
+
+    double tolerance() const { return m_tolerance; }
+
+    // Путь до maxReflections отражений или до отражения, на котором найден цикл;
+    // точки уходят в sink, как у LightRay::trace
+    Orbit trace(const QPointF& startPoint, double startAngle, int maxReflections, PathSink& sink) const;
+    // Только орбита, без пути
+    Orbit findOrbit(const QPointF& startPoint, double startAngle, int maxReflections) const;
+
+private:
+    struct Key {
+        int wall;
+        double position;
+        double directionX;
+        double directionY;
+    };
+
+    const WallTable* m_table;
+    const WallIndex* m_index;
+    double m_tolerance;
+
+    Key key(const LightRay::State& state) const;
+    bool matches(const Key& a, const Key& b) const;
+};
+
+#endif // ORBITTRACER_H
@@ -0,0 +1,160 @@
+#include "packettracer.h"
+#include "lightray.h"
+
+namespace {
+
+// Пакетный поиск стоит столько же, сколько при полном пакете,
+// поэтому пакеты меньше половины ширины распускаются на одиночные лучи
+const int MinPacketRays = WallKernel::MaxLanes / 2;
+
+struct Packet {
+    QVector<int> rays;  // номера лучей в веере
+    int reflections;    // уже выполнено отражений
+};
+
+}
+
+PacketTracer::PacketTracer(const WallTable& table, const WallIndex* index)
+    : m_table(&table)
+    , m_index(index)
+{
+}
+
+QVector<QVector<QPointF>> PacketTracer::traceFan(const QPointF& startPoint, const QVector<double>& angles,
+                                                 int maxReflections) const
+{
+    QVector<QVector<QPointF>> paths(angles.size());
+    QVector<PathSink*> sinks;
+    for (QVector<QPointF>& path : paths) {
+        sinks.append(new PathCollector(path));
+    }
+    traceFan(startPoint, angles, maxReflections, sinks);
+    qDeleteAll(sinks);
+    return paths;
+}
+
+void PacketTracer::traceFan(const QPointF& startPoint, const QVector<double>& angles, int maxReflections,
+                            const QVector<PathSink*>& sinks) const
+{
+    if (m_table->hasArcs()) {
+        tracePackets<true>(startPoint, angles, maxReflections, sinks);
+    } else {
+        tracePackets<false>(startPoint, angles, maxReflections, sinks);
+    }
+}
+
+template <bool Curved>
+void PacketTracer::tracePackets(const QPointF& startPoint, const QVector<double>& angles, int maxReflections,
+                                const QVector<PathSink*>& sinks) const
+{
+    const int lanes = WallKernel::MaxLanes;
+
+    QVector<QPointF> points(angles.size(), startPoint);
+    QVector<QPointF> directions(angles.size());
+    QVector<int> lastWalls(angles.size(), -1);
+    for (int ray = 0; ray < angles.size(); ++ray) {
+        directions[ray] = LightRay::directionForAngle(angles[ray]);
+    }
+
+    // Шаг луча после попадания - тот же, что в LightRay::calculatePath;
+    // false - приемник луча попросил остановиться
+    auto advance = [&](int ray, int wall, double distance) {
+        QPointF intersection = points[ray] + directions[ray] * distance;
+        points[ray] = intersection;
+        directions[ray] = LightRay::reflectedDirection<Curved>(*m_table, wall, intersection,
+                                                               directions[ray]);
+        lastWalls[ray] = wall;
+        return sinks[ray]->addPoint(intersection, wall);
+    };
+    const double minDistance = m_table->minHitDistance();
+
+    // Соседние углы - в один пакет
+    QVector<Packet> pending;
+    for (int first = 0; first < angles.size(); first += lanes) {
+        Packet packet;
+        packet.reflections = 0;
+        for (int ray = first; ray < qMin(first + lanes, int(angles.size())); ++ray) {
+            if (sinks[ray]->addPoint(startPoint, PathSink::RayStart)) {
+                packet.rays.append(ray);
+            }
+        }
+        pending.append(packet);
+    }
+
+    while (!pending.isEmpty()) {
+        Packet packet = pending.takeLast();
+
+        while (packet.reflections < maxReflections && packet.rays.size() >= MinPacketRays) {
+            WallKernel::RayPacket rays;
+            for (int lane = 0; lane < lanes; ++lane) {
+                bool used = lane < packet.rays.size();
+                QPointF origin = used ? points[packet.rays[lane]] : QPointF();
+                QPointF direction = used ? directions[packet.rays[lane]] : QPointF();
+                rays.originX[lane] = origin.x();
+                rays.originY[lane] = origin.y();
+                rays.directionX[lane] = direction.x();
+                rays.directionY[lane] = direction.y();
+            }
+
+            // Пакет делится по стенам попадания, поэтому последняя стена у всех его лучей одна
+            int excludeWall = lastWalls[packet.rays.first()];
+            int hitWalls[lanes];
+            double distances[lanes];
+            if (m_index) {
+                m_index->findNextWalls(rays, LightRay::RayLength, minDistance, excludeWall, hitWalls, distances);
+            } else {
+                m_table->findNextWalls(rays, LightRay::RayLength, minDistance, excludeWall, hitWalls, distances);
+            }
+
+            // Лучи, ушедшие в другие стены, чем первый оставшийся, уходят в отдельные пакеты
+            QVector<Packet> split;
+            QVector<int> splitWalls;
+            QVector<int> kept;
+            int keptWall = -1;
+
+            for (int lane = 0; lane < packet.rays.size(); ++lane) {
+                int ray = packet.rays[lane];
+                int wall = hitWalls[lane];
+                if (wall < 0) continue; // луч ушел из комнаты
+                if (!advance(ray, wall, distances[lane])) continue;
+
+                if (keptWall < 0 || wall == keptWall) {
+                    keptWall = wall;
+                    kept.append(ray);
+                    continue;
+                }
+
+                int group = splitWalls.indexOf(wall);
+                if (group < 0) {
+                    group = split.size();
+                    splitWalls.append(wall);
+                    split.append(Packet{QVector<int>(), packet.reflections + 1});
+                }
+                split[group].rays.append(ray);
+            }
+
+            pending.append(split);
+            packet.rays = kept;
+            ++packet.reflections;
+        }
+
+        // Оставшиеся лучи - обычный поиск по одному
+        for (int ray : packet.rays) {
+            for (int i = packet.reflections; i < maxReflections; ++i) {
+                double distance;
+                int wall;
+                if (m_index) {
+                    wall = m_index->findNextWall(points[ray], directions[ray], LightRay::RayLength,
+                                                 minDistance, lastWalls[ray], distance);
+                } else if (Curved) {
+                    wall = m_table->findNextWall(points[ray], directions[ray], LightRay::RayLength,
+                                                 minDistance, lastWalls[ray], distance);
+                } else {
+                    wall = m_table->findNextFlatWall(points[ray], directions[ray], LightRay::RayLength,
+                                                     minDistance, lastWalls[ray], distance);
+                }
+                if (wall < 0 || !advance(ray, wall, distance)) break;
+            }
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef PACKETTRACER_H
+#define PACKETTRACER_H
+
+#include <QPointF>
+#include <QVector>
+#include "pathsink.h"
+#include "walltable.h"
+#include "wallindex.h"
+
+// Трассировка веера лучей из одной точки пакетами по WallKernel::MaxLanes лучей.
+// Соседние по углу лучи первые отражения идут рядом и попадают в одни и те же стены,
+// поэтому их проверяют против стен вместе: данные стены (или узел BVH) загружаются
+// один раз на весь пакет. Как только лучи пакета попадают в разные стены,
+// пакет делится по стенам; оставшиеся в одиночестве лучи трассируются по одному.
+// Пути побитово совпадают с LightRay для тех же углов.
+class PacketTracer
+{
+public:
+    // table и index - как у LightRay, должны жить дольше трассировщика
+    PacketTracer(const WallTable& table, const WallIndex* index = nullptr);
+
+    // Пути в порядке angles; первая точка каждого пути - startPoint
+    QVector<QVector<QPointF>> traceFan(const QPointF& startPoint, const QVector<double>& angles,
+                                       int maxReflections = 50) const;
+    // То же без хранения путей: точки луча angles[i] уходят в sinks[i] по мере отражений.
+    // Луч, приемник которого вернул false, дальше не трассируется
+    void traceFan(const QPointF& startPoint, const QVector<double>& angles, int maxReflections,
+                  const QVector<PathSink*>& sinks) const;
+
+private:
+    const WallTable* m_table;
+    const WallIndex* m_index;
+
+    // Ветка выбирается один раз по WallTable::hasArcs(), как в LightRay
+    template <bool Curved>
+    void tracePackets(const QPointF& startPoint, const QVector<double>& angles, int maxReflections,
+                      const QVector<PathSink*>& sinks) const;
+};
+
+#endif // PACKETTRACER_H
@@ -0,0 +1,89 @@
+#include "pathsink.h"
+#include <cmath>
+
+PathRingBuffer::PathRingBuffer(int capacity)
+    : m_capacity(qMax(1, capacity))
+    , m_total(0)
+{
+    m_points.reserve(m_capacity);
+}
+
+bool PathRingBuffer::addPoint(const QPointF& point, int)
+{
+    // Пока буфер не заполнен, точки добавляются в конец, дальше - по кругу
+    if (m_points.size() < m_capacity) {
+        m_points.append(point);
+    } else {
+        m_points[m_total % m_points.size()] = point;
+    }
+    ++m_total;
+    return true;
+}
+
+QVector<QPointF> PathRingBuffer::points() const
+{
+    if (m_total <= m_points.size()) return m_points;
+
+    int oldest = m_total % m_points.size();
+    return m_points.mid(oldest) + m_points.mid(0, oldest);
+}
+
+PathCsvWriter::PathCsvWriter(QTextStream& out, int ray, qint64 firstIndex)
+    : m_out(&out)
+    , m_ray(ray)
+    , m_index(firstIndex)
+{
+}
+
+bool PathCsvWriter::addPoint(const QPointF& point, int)
+{
+    if (m_ray >= 0) *m_out << m_ray << ',';
+    *m_out << m_index++ << ',' << point.x() << ',' << point.y() << '\n';
+    return m_out->status() == QTextStream::Ok;
+}
+
+PathStatistics::PathStatistics()
+    : m_rays(0)
+    , m_reflections(0)
+    , m_length(0.0)
+{
+}
+
+bool PathStatistics::addPoint(const QPointF& point, int wall)
+{
+    if (m_rays == 0 && m_reflections == 0) {
+        m_bounds = QRectF(point, point);
+    } else {
+        m_bounds.setLeft(qMin(m_bounds.left(), point.x()));
+        m_bounds.setTop(qMin(m_bounds.top(), point.y()));
+        m_bounds.setRight(qMax(m_bounds.right(), point.x()));
+        m_bounds.setBottom(qMax(m_bounds.bottom(), point.y()));
+    }
+
+    if (wall == RayStart) {
+        ++m_rays;
+    } else {
+        ++m_reflections;
+        m_length += std::hypot(point.x() - m_last.x(), point.y() - m_last.y());
+    }
+    m_last = point;
+    return true;
+}
+
+void PathStatistics::merge(const PathStatistics& other)
+{
+    if (other.m_rays == 0 && other.m_reflections == 0) return;
+
+    if (m_rays == 0 && m_reflections == 0) {
+        m_bounds = other.m_bounds;
+    } else {
+        m_bounds.setLeft(qMin(m_bounds.left(), other.m_bounds.left()));
+        m_bounds.setTop(qMin(m_bounds.top(), other.m_bounds.top()));
+        m_bounds.setRight(qMax(m_bounds.right(), other.m_bounds.right()));
+        m_bounds.setBottom(qMax(m_bounds.bottom(), other.m_bounds.bottom()));
+    }
+    m_rays += other.m_rays;
+    m_reflections += other.m_reflections;
+    m_length += other.m_length;
+    m_last = other.m_last;
+}
@@ -0,0 +1,116 @@
+#ifndef PATHSINK_H
+#define PATHSINK_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QTextStream>
+#include <QVector>
+#include <functional>
+
+// Приемник точек пути луча. Трассировщик отдает точки по одной по мере отражений,
+// поэтому путь не обязан храниться целиком: память не растет с числом отражений,
+// если приемник сам ее не копит (как PathCollector).
+class PathSink
+{
+public:
+    virtual ~PathSink() {}
+
+    // Номер стены у начала луча и у отражения, стена которого не сохранилась
+    // (пути, собранные в QVector<QPointF>, хранят только точки)
+    static const int RayStart = -1;
+    static const int UnknownWall = -2;
+
+    // Первая точка - начало луча (wall == RayStart), дальше точки отражения от стены wall
+    // или UnknownWall. false - трассировку прервать после этой точки
+    virtual bool addPoint(const QPointF& point, int wall) = 0;
+};
+
+// Весь путь в вектор - прежнее поведение LightRay::path()
+class PathCollector : public PathSink
+{
+public:
+    explicit PathCollector(QVector<QPointF>& path) : m_path(&path) {}
+
+    bool addPoint(const QPointF& point, int) override
+    {
+        m_path->append(point);
+        return true;
+    }
+
+private:
+    QVector<QPointF>* m_path;
+};
+
+// Произвольная функция на каждую точку
+class PathCallback : public PathSink
+{
+public:
+    typedef std::function<bool(const QPointF& point, int wall)> Function;
+
+    explicit PathCallback(const Function& function) : m_function(function) {}
+
+    bool addPoint(const QPointF& point, int wall) override { return m_function(point, wall); }
+
+private:
+    Function m_function;
+};
+
+// Последние capacity точек пути, например хвост очень длинной траектории
+class PathRingBuffer : public PathSink
+{
+public:
+    explicit PathRingBuffer(int capacity);
+
+    bool addPoint(const QPointF& point, int wall) override;
+
+    // Сохраненные точки от старой к новой
+    QVector<QPointF> points() const;
+    // Сколько точек прошло всего, включая вытесненные
+    qint64 total() const { return m_total; }
+
+private:
+    QVector<QPointF> m_points;
+    int m_capacity;
+    qint64 m_total;
+};
+
+// Строки CSV "index,x,y" или "ray,index,x,y", если задан номер луча;
+// firstIndex - номер первой точки, когда путь дописывается с середины
+class PathCsvWriter : public PathSink
+{
+public:
+    explicit PathCsvWriter(QTextStream& out, int ray = -1, qint64 firstIndex = 0);
+
+    bool addPoint(const QPointF& point, int wall) override;
+
+private:
+    QTextStream* m_out;
+    int m_ray;
+    qint64 m_index;
+};
+
+// Сводка по путям без хранения точек: число лучей и отражений, длина, охват
+class PathStatistics : public PathSink
+{
+public:
+    PathStatistics();
+
+    bool addPoint(const QPointF& point, int wall) override;
+    // Добавляет сводку других лучей, например собранную в другом потоке
+    void merge(const PathStatistics& other);
+
+    // Начала лучей (точки с wall == RayStart) и отражения, в том числе от UnknownWall
+    qint64 rays() const { return m_rays; }
+    qint64 reflections() const { return m_reflections; }
+    double length() const { return m_length; }
+    QRectF bounds() const { return m_bounds; }
+
+private:
+    qint64 m_rays;
+    qint64 m_reflections;
+    double m_length;
+    QRectF m_bounds;
+    QPointF m_last;
+};
+
+#endif // PATHSINK_H
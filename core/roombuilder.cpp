@@ -0,0 +1,30 @@
+#include "roombuilder.h"
+#include <cmath>
+
+QVector<Wall*> RoomBuilder::createWalls(const QVector<QPointF>& vertices)
+{
+    QVector<Wall*> walls;
+    walls.reserve(vertices.size());
+
+    for (int i = 0; i < vertices.size(); ++i) {
+        QPointF start = vertices[i];
+        QPointF end = vertices[(i + 1) % vertices.size()];
+        walls.append(new Wall(start, end));
+    }
+
+    return walls;
+}
+
+QVector<QPointF> RoomBuilder::regularPolygon(int count, const QPointF& center, double radius)
+{
+    QVector<QPointF> vertices;
+    vertices.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        double angle = 2 * M_PI * i / count - M_PI / 2;
+        vertices.append(QPointF(center.x() + radius * cos(angle),
+                                center.y() + radius * sin(angle)));
+    }
+
+    return vertices;
+}
@@ -0,0 +1,20 @@
+#ifndef ROOMBUILDER_H
+#define ROOMBUILDER_H
+
+#include <QPointF>
+#include <QVector>
+#include "wall.h"
+
+// Построение геометрии комнаты без привязки к виджету,
+// чтобы GUI и mirrortrace получали одинаковые стены
+class RoomBuilder
+{
+public:
+    // Замкнутый многоугольник: стена i соединяет вершины i и i+1
+    static QVector<Wall*> createWalls(const QVector<QPointF>& vertices);
+
+    // Вершины правильного многоугольника, первая вершина - сверху
+    static QVector<QPointF> regularPolygon(int count, const QPointF& center, double radius);
+};
+
+#endif // ROOMBUILDER_H
@@ -0,0 +1,89 @@
+#include "roomfile.h"
+#include <QFile>
+#include <QTextStream>
+
+bool RoomFile::load(const QString& filename, QVector<Wall*>& walls, QString* errorMessage)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        if (errorMessage) *errorMessage = file.errorString();
+        return false;
+    }
+
+    QVector<Wall*> loaded;
+    QTextStream in(&file);
+    int lineNumber = 0;
+
+    while (!in.atEnd()) {
+        QString line = in.readLine().trimmed();
+        ++lineNumber;
+
+        if (line.isEmpty() || line.startsWith('#')) continue;
+
+        QStringList fields = line.split(' ', Qt::SkipEmptyParts);
+        bool ok = fields.size() >= 4;
+        double coords[4];
+        for (int i = 0; ok && i < 4; ++i) {
+            coords[i] = fields[i].toDouble(&ok);
+        }
+
+        Wall* wall = ok ? new Wall(QPointF(coords[0], coords[1]), QPointF(coords[2], coords[3]))
+                        : nullptr;
+
+        if (ok && fields.size() > 4) {
+            QString type = fields[4].toLower();
+            if (type == "flat" && fields.size() == 5) {
+                wall->setMirrorType(Wall::Flat);
+            } else if ((type == "concave" || type == "convex") && fields.size() == 6) {
+                wall->setMirrorType(Wall::Spherical);
+                wall->setSphericalType(type == "concave" ? Wall::Concave : Wall::Convex);
+                wall->setRadius(fields[5].toDouble(&ok));
+            } else {
+                ok = false;
+            }
+        }
+
+        if (!ok) {
+            delete wall;
+            qDeleteAll(loaded);
+            if (errorMessage) {
+                *errorMessage = QString("%1:%2: malformed wall \"%3\"")
+                                    .arg(filename).arg(lineNumber).arg(line);
+            }
+            return false;
+        }
+
+        loaded.append(wall);
+    }
+
+    walls = loaded;
+    return true;
+}
+
+bool RoomFile::save(const QString& filename, const QVector<Wall*>& walls, QString* errorMessage)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        if (errorMessage) *errorMessage = file.errorString();
+        return false;
+    }
+
+    QTextStream out(&file);
+    out.setRealNumberPrecision(17);
+    out << "# x1 y1 x2 y2 [flat | concave <radius> | convex <radius>]\n";
+
+    for (const Wall* wall : walls) {
+        out << wall->startPoint().x() << ' ' << wall->startPoint().y() << ' '
+            << wall->endPoint().x() << ' ' << wall->endPoint().y() << ' ';
+
+        if (wall->mirrorType() == Wall::Flat) {
+            out << "flat";
+        } else {
+            out << (wall->sphericalType() == Wall::Concave ? "concave " : "convex ")
+                << wall->radius();
+        }
+        out << '\n';
+    }
+
+    return true;
+}
@@ -0,0 +1,21 @@
+#ifndef ROOMFILE_H
+#define ROOMFILE_H
+
+#include <QString>
+#include <QVector>
+#include "wall.h"
+
+// Текстовый формат комнаты, одна стена на строку:
+//   x1 y1 x2 y2 [flat | concave <radius> | convex <radius>]
+// Пустые строки и строки, начинающиеся с '#', пропускаются.
+class RoomFile
+{
+public:
+    // При ошибке возвращает false, walls не изменяется
+    static bool load(const QString& filename, QVector<Wall*>& walls,
+                     QString* errorMessage = nullptr);
+    static bool save(const QString& filename, const QVector<Wall*>& walls,
+                     QString* errorMessage = nullptr);
+};
+
+#endif // ROOMFILE_H
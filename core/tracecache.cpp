@@ -0,0 +1,25 @@
+#include "tracecache.h"
+
+TraceCache::TraceCache(qsizetype budget)
+    : m_rays(budget)
+{
+}
+
+const LightRay* TraceCache::find(const Key& key)
+{
+    return m_rays.object(key);
+}
+
+void TraceCache::insert(const Key& key, const LightRay& ray)
+{
+    // Лениво посчитанный путь мог быть неполным: стоимость - то, что уже лежит в памяти
+    qsizetype cost = qsizetype(sizeof(LightRay))
+                     + qsizetype(ray.reflections() + 1) * qsizetype(sizeof(QPointF) + sizeof(int));
+    m_rays.insert(key, new LightRay(ray), cost);
+}
+
+size_t qHash(const TraceCache::Key& key, size_t seed) noexcept
+{
+    return qHashMulti(seed, key.roomHash, key.startPoint.x(), key.startPoint.y(), key.startAngle,
+                      key.maxReflections);
+}
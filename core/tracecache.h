@@ -0,0 +1,55 @@
+#ifndef TRACECACHE_H
+#define TRACECACHE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QPointF>
+#include "lightray.h"
+
+// LRU-кэш трассированных лучей поверх QCache. Ключ - хэш комнаты (WallTable::hash()),
+// точка старта, угол и предел отражений: одинаковый ключ дает побитово тот же путь.
+// Хранятся копии LightRay; путь в QVector разделяется неявно, поэтому копия дешевая.
+// Стоимость луча - байты уже посчитанных точек; при превышении бюджета
+// вытесняются давно не использованные лучи
+class TraceCache
+{
+public:
+    struct Key {
+        QByteArray roomHash;
+        QPointF startPoint;
+        double startAngle;
+        int maxReflections;
+
+        bool operator==(const Key& other) const
+        {
+            return roomHash == other.roomHash && startPoint == other.startPoint
+                   && startAngle == other.startAngle && maxReflections == other.maxReflections;
+        }
+    };
+
+    // 64 МБ - несколько миллионов точек
+    static const qsizetype DefaultBudget = qsizetype(64) << 20;
+
+    explicit TraceCache(qsizetype budget = DefaultBudget);
+
+    void setBudget(qsizetype budget) { m_rays.setMaxCost(budget); }
+    qsizetype budget() const { return m_rays.maxCost(); }
+    // Занятая память в байтах
+    qsizetype size() const { return m_rays.totalCost(); }
+    qsizetype count() const { return m_rays.count(); }
+
+    // Луч по ключу или nullptr; найденный становится самым свежим.
+    // Указатель действителен до следующего insert() или clear()
+    const LightRay* find(const Key& key);
+    // Запоминает копию луча; прежний луч с тем же ключом заменяется.
+    // Луч больше всего бюджета не сохраняется
+    void insert(const Key& key, const LightRay& ray);
+    void clear() { m_rays.clear(); }
+
+private:
+    QCache<Key, LightRay> m_rays;
+};
+
+size_t qHash(const TraceCache::Key& key, size_t seed = 0) noexcept;
+
+#endif // TRACECACHE_H
@@ -0,0 +1,177 @@
+#include "wall.h"
+#include <QAtomicInteger>
+#include <cmath>
+
+Wall::Wall(const QPointF& start, const QPointF& end)
+    : m_line(start, end)
+    , m_mirrorType(Flat)
+    , m_sphericalType(Concave)
+    , m_radius(100.0)
+    , m_revision(nextRevision())
+{
+}
+
+quint64 Wall::nextRevision()
+{
+    // Стены создаются и в рабочих потоках (RoomBuilder), поэтому счетчик атомарный
+    static QAtomicInteger<quint64> counter(0);
+    return counter.fetchAndAddRelaxed(1) + 1;
+}
+
+bool Wall::containsPoint(const QPointF& point) const
+{
+    // Проверяем расстояние до всей линии стены, а не только до конечных точек
+    double distance = distanceToPoint(point);
+    return distance < 25.0; // Достаточно большой порог для выбора всей стены
+}
+
+double Wall::curvatureRadius() const
+{
+    return qMax(m_radius, length() / 2);
+}
+
+QPointF Wall::curvatureCenter() const
+{
+    QPointF middle = (m_line.p1() + m_line.p2()) / 2;
+    QLineF normal = m_line.normalVector().unitVector();
+    QPointF unitNormal = normal.p2() - normal.p1();
+
+    double radius = curvatureRadius();
+    double halfChord = length() / 2;
+    double offset = std::sqrt(qMax(0.0, radius * radius - halfChord * halfChord));
+
+    return m_sphericalType == Concave ? middle + unitNormal * offset : middle - unitNormal * offset;
+}
+
+QPointF Wall::arcMiddle() const
+{
+    // Дуга выгибается от центра кривизны, в сторону, противоположную ему относительно хорды
+    QLineF normal = m_line.normalVector().unitVector();
+    QPointF unitNormal = normal.p2() - normal.p1();
+    double radius = curvatureRadius();
+
+    return m_sphericalType == Concave ? curvatureCenter() - unitNormal * radius
+                                      : curvatureCenter() + unitNormal * radius;
+}
+
+bool Wall::arcContains(const QPointF& point) const
+{
+    // Меньшая дуга - точки окружности по ту сторону хорды, где нет центра
+    QPointF toPoint = point - m_line.p1();
+    QPointF toMiddle = arcMiddle() - m_line.p1();
+    double side = m_line.dx() * toPoint.y() - m_line.dy() * toPoint.x();
+    double arcSide = m_line.dx() * toMiddle.y() - m_line.dy() * toMiddle.x();
+    return side * arcSide >= 0.0;
+}
+
+QPointF Wall::pointAt(double t) const
+{
+    if (!isArc()) return m_line.pointAt(t);
+
+    QPointF center = curvatureCenter();
+    QPointF from = m_line.p1() - center;
+    QPointF middle = arcMiddle() - center;
+
+    // Половина угла дуги со знаком - от начала до середины дуги
+    double halfSpan = std::atan2(from.x() * middle.y() - from.y() * middle.x(),
+                                 from.x() * middle.x() + from.y() * middle.y());
+    double angle = std::atan2(from.y(), from.x()) + 2 * halfSpan * t;
+    return center + curvatureRadius() * QPointF(std::cos(angle), std::sin(angle));
+}
+
+QPointF Wall::reflectPoint(const QPointF& point) const
+{
+    // Зеркальное отражение относительно прямой стены, для дуги -
+    // относительно касательной в ближайшей к точке точке дуги
+    QLineF mirrorLine = m_line;
+    if (isArc()) {
+        QPointF touch = getClosestPoint(point);
+        QLineF radius(curvatureCenter(), touch);
+        mirrorLine = radius.normalVector().translated(touch - radius.p1());
+    }
+
+    double l2 = mirrorLine.dx() * mirrorLine.dx() + mirrorLine.dy() * mirrorLine.dy();
+    if (l2 == 0.0) return point;
+
+    QPointF projected = mirrorLine.pointAt(
+        ((point.x() - mirrorLine.x1()) * mirrorLine.dx() +
+         (point.y() - mirrorLine.y1()) * mirrorLine.dy()) / l2);
+
+    return 2 * projected - point;
+}
+
+double Wall::distanceToPoint(const QPointF& point) const
+{
+    if (isArc()) return QLineF(point, getClosestPoint(point)).length();
+
+    // Вычисляем расстояние от точки до отрезка AB
+    QPointF A = m_line.p1();
+    QPointF B = m_line.p2();
+
+    double l2 = (B.x() - A.x())*(B.x() - A.x()) + (B.y() - A.y())*(B.y() - A.y());
+    if (l2 == 0.0) return QLineF(point, A).length(); // A == B
+
+    // Consider the line extending the segment, parameterized as A + t (B - A)
+    double t = ((point.x() - A.x()) * (B.x() - A.x()) + (point.y() - A.y()) * (B.y() - A.y())) / l2;
+    t = qMax(0.0, qMin(1.0, t)); // Clamp t to [0,1]
+
+    QPointF projection(A.x() + t * (B.x() - A.x()), A.y() + t * (B.y() - A.y()));
+    return QLineF(point, projection).length();
+}
+
+QPointF Wall::getClosestPoint(const QPointF& point) const
+{
+    if (isArc()) {
+        // Проекция на окружность, если она попала на дугу, иначе ближайший конец
+        QPointF center = curvatureCenter();
+        QLineF toPoint(center, point);
+        if (toPoint.length() > 0.0) {
+            toPoint.setLength(curvatureRadius());
+            if (arcContains(toPoint.p2())) return toPoint.p2();
+        }
+        return QLineF(point, m_line.p1()).length() <= QLineF(point, m_line.p2()).length()
+                   ? m_line.p1() : m_line.p2();
+    }
+
+    // Находим ближайшую точку на отрезке AB к заданной точке
+    QPointF A = m_line.p1();
+    QPointF B = m_line.p2();
+
+    double l2 = (B.x() - A.x())*(B.x() - A.x()) + (B.y() - A.y())*(B.y() - A.y());
+    if (l2 == 0.0) return A; // A == B
+
+    // Consider the line extending the segment, parameterized as A + t (B - A)
+    double t = ((point.x() - A.x()) * (B.x() - A.x()) + (point.y() - A.y()) * (B.y() - A.y())) / l2;
+    t = qMax(0.0, qMin(1.0, t)); // Clamp t to [0,1]
+
+    return QPointF(A.x() + t * (B.x() - A.x()), A.y() + t * (B.y() - A.y()));
+}
+
+QString Wall::getTypeString() const
+{
+    switch (m_mirrorType) {
+    case Flat: return "Flat";
+    case Spherical: return getSphericalTypeString();
+    default: return "Unknown";
+    }
+}
+
+QString Wall::getSphericalTypeString() const
+{
+    switch (m_sphericalType) {
+    case Concave: return "Concave";
+    case Convex: return "Convex";
+    default: return "Unknown";
+    }
+}
+
+QString Wall::toString() const
+{
+    return QString("Wall: (%1,%2) -> (%3,%4), Type: %5, Radius: %6")
+    .arg(m_line.p1().x())
+        .arg(m_line.p1().y())
+        .arg(m_line.p2().x())
+        .arg(m_line.p2().y())
+        .arg(getTypeString())
+        .arg(m_radius);
+}
@@ -0,0 +1,73 @@
+#ifndef WALL_H
+#define WALL_H
+
+#include <QPointF>
+#include <QLineF>
+#include <QString>
+
+class Wall
+{
+public:
+    enum MirrorType {
+        Flat,
+        Spherical
+    };
+
+    enum SphericalType {
+        Concave,
+        Convex
+    };
+
+    Wall(const QPointF& start, const QPointF& end);
+
+    // Setters. Каждый дает стене новую revision(): по ней видно, что таблицу стен,
+    // хэш комнаты и картинку стен пора пересчитать
+    void setMirrorType(MirrorType type) { m_mirrorType = type; m_revision = nextRevision(); }
+    void setSphericalType(SphericalType type) { m_sphericalType = type; m_revision = nextRevision(); }
+    void setRadius(double radius) { m_radius = radius; m_revision = nextRevision(); }
+
+    // Getters
+    MirrorType mirrorType() const { return m_mirrorType; }
+    SphericalType sphericalType() const { return m_sphericalType; }
+    double radius() const { return m_radius; }
+    QLineF line() const { return m_line; }
+    QPointF startPoint() const { return m_line.p1(); }
+    QPointF endPoint() const { return m_line.p2(); }
+    double length() const { return m_line.length(); }
+    // Номер версии стены, общий счетчик для всех стен: новая стена
+    // не совпадает по ревизии с удаленной, даже если заняла ее место в комнате
+    quint64 revision() const { return m_revision; }
+
+    // Сферическое зеркало - дуга окружности над хордой line().
+    // Центр кривизны вогнутого зеркала лежит со стороны line().normalVector(),
+    // выпуклого - с противоположной; стрелка в GUI указывает на центр кривизны.
+    // Радиус меньше половины хорды увеличивается до нее (полуокружность)
+    bool isArc() const { return m_mirrorType == Spherical && length() > 0.0; }
+    double curvatureRadius() const;
+    QPointF curvatureCenter() const;
+    QPointF arcMiddle() const;
+    bool arcContains(const QPointF& point) const;
+
+    // Точка стены с параметром 0..1: на хорде или на дуге
+    QPointF pointAt(double t) const;
+
+    bool containsPoint(const QPointF& point) const;
+    QPointF reflectPoint(const QPointF& point) const;
+    double distanceToPoint(const QPointF& point) const;
+    QPointF getClosestPoint(const QPointF& point) const;
+
+    QString toString() const;
+    QString getTypeString() const;
+
+private:
+    QLineF m_line;
+    MirrorType m_mirrorType;
+    SphericalType m_sphericalType;
+    double m_radius;
+    quint64 m_revision;
+
+    QString getSphericalTypeString() const;
+    static quint64 nextRevision();
+};
+
+#endif // WALL_H
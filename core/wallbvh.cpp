@@ -0,0 +1,347 @@
+#include "wallbvh.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+const int BinCount = 16;
+const int MaxLeafSize = 4;
+const int MaxDepth = 60;           // глубина стека обхода - 64
+const double TraversalCost = 1.0;  // относительно одной проверки стены
+}
+
+WallBvh::WallBvh()
+    : m_table(nullptr)
+{
+}
+
+void WallBvh::clear()
+{
+    m_table = nullptr;
+    m_nodes.clear();
+    m_wallOrder.clear();
+}
+
+void WallBvh::build(const WallTable& table)
+{
+    clear();
+    if (table.isEmpty()) return;
+
+    m_table = &table;
+
+    int count = table.size();
+    double extent = 1.0;
+    QVector<QRectF> rects(count);
+    for (int i = 0; i < count; ++i) {
+        rects[i] = table.bounds(i);
+        extent = qMax(extent, qMax(qMax(std::abs(rects[i].left()), std::abs(rects[i].right())),
+                                   qMax(std::abs(rects[i].top()), std::abs(rects[i].bottom()))));
+    }
+
+    // Прямоугольники стен чуть расширены: у горизонтальных и вертикальных стен они вырождены,
+    // и без запаса ошибка округления в тесте прямоугольника могла бы потерять попадание
+    double eps = extent * 1e-9;
+
+    QVector<Bounds> wallBounds(count);
+    QVector<QPointF> centroids(count);
+    m_wallOrder.resize(count);
+
+    for (int i = 0; i < count; ++i) {
+        const QRectF& rect = rects[i];
+        wallBounds[i] = {rect.left() - eps, rect.top() - eps, rect.right() + eps, rect.bottom() + eps};
+        centroids[i] = rect.center();
+        m_wallOrder[i] = i;
+    }
+
+    m_nodes.reserve(2 * count);
+    m_nodes.append(Node());
+    subdivide(0, wallBounds, centroids, 0, count, 0);
+    m_nodes.squeeze();
+}
+
+void WallBvh::subdivide(int nodeIndex, const QVector<Bounds>& wallBounds,
+                        const QVector<QPointF>& centroids, int first, int count, int depth)
+{
+    auto halfPerimeter = [](const Bounds& b) { return (b.maxX - b.minX) + (b.maxY - b.minY); };
+    auto grow = [](Bounds& b, const Bounds& other) {
+        b.minX = qMin(b.minX, other.minX);
+        b.minY = qMin(b.minY, other.minY);
+        b.maxX = qMax(b.maxX, other.maxX);
+        b.maxY = qMax(b.maxY, other.maxY);
+    };
+
+    const double inf = std::numeric_limits<double>::infinity();
+    const Bounds empty = {inf, inf, -inf, -inf};
+
+    Bounds bounds = empty;
+    double cMinX = inf, cMinY = inf, cMaxX = -inf, cMaxY = -inf;
+    for (int i = first; i < first + count; ++i) {
+        int wall = m_wallOrder[i];
+        grow(bounds, wallBounds[wall]);
+        cMinX = qMin(cMinX, centroids[wall].x());
+        cMinY = qMin(cMinY, centroids[wall].y());
+        cMaxX = qMax(cMaxX, centroids[wall].x());
+        cMaxY = qMax(cMaxY, centroids[wall].y());
+    }
+
+    m_nodes[nodeIndex].bounds = bounds;
+    m_nodes[nodeIndex].first = first;
+    m_nodes[nodeIndex].count = count;
+
+    // Ось разбиения - наибольший разброс центров стен
+    bool splitX = (cMaxX - cMinX) >= (cMaxY - cMinY);
+    double cMin = splitX ? cMinX : cMinY;
+    double cExtent = splitX ? cMaxX - cMinX : cMaxY - cMinY;
+
+    if (count <= 1 || cExtent <= 0.0 || depth >= MaxDepth) return;
+
+    auto binOf = [&](int wall) {
+        double c = splitX ? centroids[wall].x() : centroids[wall].y();
+        return qMin(BinCount - 1, int((c - cMin) / cExtent * BinCount));
+    };
+
+    int binCounts[BinCount] = {};
+    Bounds binBounds[BinCount];
+    std::fill(binBounds, binBounds + BinCount, empty);
+
+    for (int i = first; i < first + count; ++i) {
+        int wall = m_wallOrder[i];
+        int bin = binOf(wall);
+        ++binCounts[bin];
+        grow(binBounds[bin], wallBounds[wall]);
+    }
+
+    // SAH: стоимость разбиения после корзины split - сумма "количество * полупериметр" двух частей
+    double rightArea[BinCount];
+    int rightCount[BinCount];
+    Bounds accumulated = empty;
+    int accumulatedCount = 0;
+    for (int bin = BinCount - 1; bin > 0; --bin) {
+        grow(accumulated, binBounds[bin]);
+        accumulatedCount += binCounts[bin];
+        rightArea[bin] = accumulatedCount ? halfPerimeter(accumulated) : 0.0;
+        rightCount[bin] = accumulatedCount;
+    }
+
+    double parentArea = qMax(halfPerimeter(bounds), std::numeric_limits<double>::min());
+    double bestCost = inf;
+    int bestSplit = -1;
+    accumulated = empty;
+    accumulatedCount = 0;
+    for (int split = 0; split < BinCount - 1; ++split) {
+        grow(accumulated, binBounds[split]);
+        accumulatedCount += binCounts[split];
+        if (accumulatedCount == 0 || rightCount[split + 1] == 0) continue;
+
+        double cost = TraversalCost
+                      + (accumulatedCount * halfPerimeter(accumulated)
+                         + rightCount[split + 1] * rightArea[split + 1]) / parentArea;
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestSplit = split;
+        }
+    }
+
+    // Лист, если разбиение не дешевле перебора всех стен узла
+    if (bestSplit < 0 || (bestCost >= count && count <= MaxLeafSize)) return;
+
+    int* begin = m_wallOrder.data() + first;
+    int* middle = std::partition(begin, begin + count,
+                                 [&](int wall) { return binOf(wall) <= bestSplit; });
+    int leftCount = int(middle - begin);
+
+    int leftChild = m_nodes.size();
+    m_nodes.append(Node());
+    m_nodes.append(Node());
+    m_nodes[nodeIndex].first = leftChild;
+    m_nodes[nodeIndex].count = 0;
+
+    subdivide(leftChild, wallBounds, centroids, first, leftCount, depth + 1);
+    subdivide(leftChild + 1, wallBounds, centroids, first + leftCount, count - leftCount, depth + 1);
+}
+
+bool WallBvh::intersectBounds(const Bounds& bounds, const QPointF& origin,
+                              const QPointF& inverseDirection, double tMax, double& tEnter)
+{
+    double t0 = 0.0;
+    double t1 = tMax;
+
+    if (std::isinf(inverseDirection.x())) {
+        if (origin.x() < bounds.minX || origin.x() > bounds.maxX) return false;
+    } else {
+        double ta = (bounds.minX - origin.x()) * inverseDirection.x();
+        double tb = (bounds.maxX - origin.x()) * inverseDirection.x();
+        t0 = qMax(t0, qMin(ta, tb));
+        t1 = qMin(t1, qMax(ta, tb));
+    }
+
+    if (std::isinf(inverseDirection.y())) {
+        if (origin.y() < bounds.minY || origin.y() > bounds.maxY) return false;
+    } else {
+        double ta = (bounds.minY - origin.y()) * inverseDirection.y();
+        double tb = (bounds.maxY - origin.y()) * inverseDirection.y();
+        t0 = qMax(t0, qMin(ta, tb));
+        t1 = qMin(t1, qMax(ta, tb));
+    }
+
+    tEnter = t0;
+    return t0 <= t1;
+}
+
+int WallBvh::findNextWall(const QPointF& origin, const QPointF& direction,
+                          double maxDistance, double minDistance, int excludeWall,
+                          double& distance) const
+{
+    if (m_nodes.isEmpty()) return -1;
+    // Нулевое направление: обратные компоненты бесконечны, проверка коробок вырождается
+    if (direction.isNull()) return -1;
+
+    QPointF inverseDirection(1.0 / direction.x(), 1.0 / direction.y());
+
+    int closest = -1;
+    double minFound = std::numeric_limits<double>::max();
+
+    double tEnter;
+    if (!intersectBounds(m_nodes[0].bounds, origin, inverseDirection, maxDistance, tEnter)) {
+        return -1;
+    }
+
+    int stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    const Node* nodes = m_nodes.constData();
+
+    while (stackSize > 0) {
+        const Node& node = nodes[stack[--stackSize]];
+
+        if (node.count > 0) {
+            for (int i = node.first; i < node.first + node.count; ++i) {
+                int wall = m_wallOrder[i];
+                double t;
+                if (m_table->hitWall(wall, origin.x(), origin.y(), direction.x(), direction.y(),
+                                     minDistance, maxDistance, excludeWall, t)) {
+                    // При равных расстояниях побеждает меньший индекс, как при линейном проходе
+                    if (t < minFound || (t == minFound && wall < closest)) {
+                        minFound = t;
+                        closest = wall;
+                    }
+                }
+            }
+            continue;
+        }
+
+        // Сначала ближний ребенок, дальний - только если он может дать попадание ближе найденного
+        double tLimit = qMin(maxDistance, minFound);
+        double tLeft;
+        double tRight;
+        bool hitLeft = intersectBounds(nodes[node.first].bounds, origin, inverseDirection, tLimit, tLeft);
+        bool hitRight = intersectBounds(nodes[node.first + 1].bounds, origin, inverseDirection, tLimit, tRight);
+
+        if (hitLeft && hitRight) {
+            if (tLeft <= tRight) {
+                stack[stackSize++] = node.first + 1;
+                stack[stackSize++] = node.first;
+            } else {
+                stack[stackSize++] = node.first;
+                stack[stackSize++] = node.first + 1;
+            }
+        } else if (hitLeft) {
+            stack[stackSize++] = node.first;
+        } else if (hitRight) {
+            stack[stackSize++] = node.first + 1;
+        }
+    }
+
+    distance = minFound;
+    return closest;
+}
+
+void WallBvh::findNextWalls(const WallKernel::RayPacket& rays,
+                            double maxDistance, double minDistance, int excludeWall,
+                            int* hitWalls, double* distances) const
+{
+    const int lanes = WallKernel::MaxLanes;
+
+    QPointF origins[lanes];
+    QPointF inverseDirections[lanes];
+    int active[lanes];
+    int activeCount = 0;
+
+    for (int lane = 0; lane < lanes; ++lane) {
+        hitWalls[lane] = -1;
+        distances[lane] = std::numeric_limits<double>::max();
+        if (rays.directionX[lane] == 0.0 && rays.directionY[lane] == 0.0) continue;
+
+        origins[lane] = QPointF(rays.originX[lane], rays.originY[lane]);
+        inverseDirections[lane] = QPointF(1.0 / rays.directionX[lane], 1.0 / rays.directionY[lane]);
+        active[activeCount++] = lane;
+    }
+
+    if (m_nodes.isEmpty() || activeCount == 0) return;
+
+    // Задевает ли прямоугольник хоть один луч пакета. Проверка останавливается на первом
+    // таком луче: у согласованного пакета это обычно первый же луч, так что узел
+    // проверяется один раз на весь пакет. tEnter этого луча задает только порядок обхода детей
+    auto packetEnters = [&](const Bounds& bounds, double& tEnter) {
+        for (int k = 0; k < activeCount; ++k) {
+            int lane = active[k];
+            if (intersectBounds(bounds, origins[lane], inverseDirections[lane],
+                                qMin(maxDistance, distances[lane]), tEnter)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    const Node* nodes = m_nodes.constData();
+
+    double tRoot;
+    if (!packetEnters(nodes[0].bounds, tRoot)) return;
+
+    int stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const Node& node = nodes[stack[--stackSize]];
+
+        if (node.count > 0) {
+            for (int i = node.first; i < node.first + node.count; ++i) {
+                int wall = m_wallOrder[i];
+                for (int k = 0; k < activeCount; ++k) {
+                    int lane = active[k];
+                    double t;
+                    if (m_table->hitWall(wall, rays.originX[lane], rays.originY[lane],
+                                         rays.directionX[lane], rays.directionY[lane],
+                                         minDistance, maxDistance, excludeWall, t)) {
+                        if (t < distances[lane] || (t == distances[lane] && wall < hitWalls[lane])) {
+                            distances[lane] = t;
+                            hitWalls[lane] = wall;
+                        }
+                    }
+                }
+            }
+            continue;
+        }
+
+        double tLeft;
+        double tRight;
+        bool hitLeft = packetEnters(nodes[node.first].bounds, tLeft);
+        bool hitRight = packetEnters(nodes[node.first + 1].bounds, tRight);
+
+        if (hitLeft && hitRight) {
+            if (tLeft <= tRight) {
+                stack[stackSize++] = node.first + 1;
+                stack[stackSize++] = node.first;
+            } else {
+                stack[stackSize++] = node.first;
+                stack[stackSize++] = node.first + 1;
+            }
+        } else if (hitLeft) {
+            stack[stackSize++] = node.first;
+        } else if (hitRight) {
+            stack[stackSize++] = node.first + 1;
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef WALLBVH_H
+#define WALLBVH_H
+
+#include "wallindex.h"
+
+// Иерархия ограничивающих прямоугольников (BVH) над отрезками стен.
+// Разбиение выбирается по SAH с биннингом (в 2D "площадь" - полупериметр),
+// поэтому комнаты со сгустками мелких стен в одном углу обрабатываются
+// так же хорошо, как и равномерные. Узлы хранятся в одном массиве,
+// дочерние узлы лежат рядом друг с другом.
+class WallBvh : public WallIndex
+{
+public:
+    WallBvh();
+
+    void build(const WallTable& table) override;
+    void clear() override;
+    int findNextWall(const QPointF& origin, const QPointF& direction,
+                     double maxDistance, double minDistance, int excludeWall,
+                     double& distance) const override;
+    // Пакет обходит дерево вместе: узел отбрасывается, только если его не задевает ни один луч
+    void findNextWalls(const WallKernel::RayPacket& rays,
+                       double maxDistance, double minDistance, int excludeWall,
+                       int* hitWalls, double* distances) const override;
+
+    int nodeCount() const { return m_nodes.size(); }
+
+private:
+    struct Bounds {
+        double minX;
+        double minY;
+        double maxX;
+        double maxY;
+    };
+
+    // count > 0 - лист со стенами m_wallOrder[first..first+count),
+    // иначе внутренний узел с детьми first и first + 1
+    struct Node {
+        Bounds bounds;
+        int first;
+        int count;
+    };
+
+    const WallTable* m_table;
+    QVector<Node> m_nodes;
+    QVector<int> m_wallOrder;
+
+    void subdivide(int nodeIndex, const QVector<Bounds>& wallBounds,
+                   const QVector<QPointF>& centroids, int first, int count, int depth);
+    static bool intersectBounds(const Bounds& bounds, const QPointF& origin,
+                                const QPointF& inverseDirection, double tMax, double& tEnter);
+};
+
+#endif // WALLBVH_H
@@ -0,0 +1,244 @@
+#include "wallgrid.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+// Примерно две ячейки на стену; больше не дает выигрыша, только раздувает память
+const double CellsPerWall = 2.0;
+const int MaxGridSide = 2048;
+}
+
+WallGrid::WallGrid()
+    : m_table(nullptr)
+    , m_minX(0.0)
+    , m_minY(0.0)
+    , m_cellWidth(1.0)
+    , m_cellHeight(1.0)
+    , m_columns(0)
+    , m_rows(0)
+{
+}
+
+void WallGrid::clear()
+{
+    m_table = nullptr;
+    m_cellStart.clear();
+    m_cellWalls.clear();
+    m_columns = 0;
+    m_rows = 0;
+}
+
+void WallGrid::build(const WallTable& table)
+{
+    clear();
+    if (table.isEmpty()) return;
+
+    m_table = &table;
+
+    // Границы сетки - охватывающий прямоугольник всех стен с небольшим запасом,
+    // чтобы точки на крайних стенах попадали внутрь
+    double minX = std::numeric_limits<double>::max();
+    double minY = std::numeric_limits<double>::max();
+    double maxX = std::numeric_limits<double>::lowest();
+    double maxY = std::numeric_limits<double>::lowest();
+
+    for (int i = 0; i < table.size(); ++i) {
+        QRectF bounds = table.bounds(i);
+        minX = qMin(minX, bounds.left());
+        minY = qMin(minY, bounds.top());
+        maxX = qMax(maxX, bounds.right());
+        maxY = qMax(maxY, bounds.bottom());
+    }
+
+    double width = maxX - minX;
+    double height = maxY - minY;
+    double extent = qMax(qMax(width, height), 1.0);
+    double margin = extent * 1e-6;
+
+    m_minX = minX - margin;
+    m_minY = minY - margin;
+    width = qMax(width, extent * 1e-3) + 2 * margin;
+    height = qMax(height, extent * 1e-3) + 2 * margin;
+
+    double targetCells = qMax(1.0, CellsPerWall * table.size());
+    m_columns = qBound(1, int(std::ceil(std::sqrt(targetCells * width / height))), MaxGridSide);
+    m_rows = qBound(1, int(std::ceil(targetCells / m_columns)), MaxGridSide);
+    m_cellWidth = width / m_columns;
+    m_cellHeight = height / m_rows;
+
+    // Два прохода: подсчет стен в ячейках, затем заполнение (CSR-раскладка)
+    QVector<int> counts(m_columns * m_rows + 1, 0);
+
+    auto forEachCell = [this](int wall, auto&& visit) {
+        QRectF bounds = m_table->bounds(wall);
+        int c0 = columnAt(bounds.left() - m_cellWidth * 1e-6);
+        int c1 = columnAt(bounds.right() + m_cellWidth * 1e-6);
+        int r0 = rowAt(bounds.top() - m_cellHeight * 1e-6);
+        int r1 = rowAt(bounds.bottom() + m_cellHeight * 1e-6);
+        // Дуга заносится во все ячейки своего прямоугольника
+        bool flat = m_table->surface(wall) == WallTable::FlatSurface;
+
+        for (int row = r0; row <= r1; ++row) {
+            for (int column = c0; column <= c1; ++column) {
+                if (!flat || segmentTouchesCell(wall, column, row)) {
+                    visit(row * m_columns + column);
+                }
+            }
+        }
+    };
+
+    for (int i = 0; i < table.size(); ++i) {
+        forEachCell(i, [&counts](int cell) { ++counts[cell + 1]; });
+    }
+
+    m_cellStart.resize(m_columns * m_rows + 1);
+    m_cellStart[0] = 0;
+    for (int cell = 0; cell < m_columns * m_rows; ++cell) {
+        m_cellStart[cell + 1] = m_cellStart[cell] + counts[cell + 1];
+    }
+
+    m_cellWalls.resize(m_cellStart.last());
+    QVector<int> fill = m_cellStart;
+    for (int i = 0; i < table.size(); ++i) {
+        forEachCell(i, [this, &fill, i](int cell) { m_cellWalls[fill[cell]++] = i; });
+    }
+}
+
+bool WallGrid::segmentTouchesCell(int wall, int column, int row) const
+{
+    // Ячейку слегка расширяем, чтобы стена на границе попала в обе соседние ячейки
+    double epsX = m_cellWidth * 1e-6;
+    double epsY = m_cellHeight * 1e-6;
+    double left = m_minX + column * m_cellWidth - epsX;
+    double top = m_minY + row * m_cellHeight - epsY;
+    double right = left + m_cellWidth + 2 * epsX;
+    double bottom = top + m_cellHeight + 2 * epsY;
+
+    // Диапазон ячеек уже ограничен охватывающим прямоугольником отрезка,
+    // остается проверить, что прямая проходит между углами ячейки
+    QPointF a = m_table->startPoint(wall);
+    double dx = m_table->direction(wall).x();
+    double dy = m_table->direction(wall).y();
+
+    int positive = 0;
+    int negative = 0;
+    for (const QPointF& corner : {QPointF(left, top), QPointF(right, top),
+                                  QPointF(left, bottom), QPointF(right, bottom)}) {
+        double side = dx * (corner.y() - a.y()) - dy * (corner.x() - a.x());
+        if (side > 0) ++positive;
+        else if (side < 0) ++negative;
+        else return true;
+    }
+
+    return positive > 0 && negative > 0;
+}
+
+int WallGrid::columnAt(double x) const
+{
+    return qBound(0, int(std::floor((x - m_minX) / m_cellWidth)), m_columns - 1);
+}
+
+int WallGrid::rowAt(double y) const
+{
+    return qBound(0, int(std::floor((y - m_minY) / m_cellHeight)), m_rows - 1);
+}
+
+int WallGrid::findNextWall(const QPointF& origin, const QPointF& direction,
+                           double maxDistance, double minDistance, int excludeWall,
+                           double& distance) const
+{
+    if (!m_table) return -1;
+    // Нулевое направление: обход сетки не сдвинулся бы с начальной ячейки
+    if (direction.isNull()) return -1;
+
+    const double inf = std::numeric_limits<double>::infinity();
+    const double dx = direction.x();
+    const double dy = direction.y();
+    const double maxX = m_minX + m_columns * m_cellWidth;
+    const double maxY = m_minY + m_rows * m_cellHeight;
+
+    // Отсекаем луч по границам сетки
+    double tEnter = 0.0;
+    double tExit = maxDistance;
+
+    if (dx != 0.0) {
+        double t1 = (m_minX - origin.x()) / dx;
+        double t2 = (maxX - origin.x()) / dx;
+        tEnter = qMax(tEnter, qMin(t1, t2));
+        tExit = qMin(tExit, qMax(t1, t2));
+    } else if (origin.x() < m_minX || origin.x() > maxX) {
+        return -1;
+    }
+
+    if (dy != 0.0) {
+        double t1 = (m_minY - origin.y()) / dy;
+        double t2 = (maxY - origin.y()) / dy;
+        tEnter = qMax(tEnter, qMin(t1, t2));
+        tExit = qMin(tExit, qMax(t1, t2));
+    } else if (origin.y() < m_minY || origin.y() > maxY) {
+        return -1;
+    }
+
+    if (tEnter > tExit) return -1;
+
+    // Начальная ячейка и параметры шага DDA
+    QPointF entry = origin + direction * tEnter;
+    int column = columnAt(entry.x());
+    int row = rowAt(entry.y());
+
+    int stepX = dx > 0 ? 1 : (dx < 0 ? -1 : 0);
+    int stepY = dy > 0 ? 1 : (dy < 0 ? -1 : 0);
+
+    double tMaxX = inf;
+    double tMaxY = inf;
+    double tDeltaX = inf;
+    double tDeltaY = inf;
+
+    if (stepX != 0) {
+        double boundary = m_minX + (column + (stepX > 0 ? 1 : 0)) * m_cellWidth;
+        tMaxX = (boundary - origin.x()) / dx;
+        tDeltaX = m_cellWidth / std::abs(dx);
+    }
+    if (stepY != 0) {
+        double boundary = m_minY + (row + (stepY > 0 ? 1 : 0)) * m_cellHeight;
+        tMaxY = (boundary - origin.y()) / dy;
+        tDeltaY = m_cellHeight / std::abs(dy);
+    }
+
+    int closest = -1;
+    double minFound = std::numeric_limits<double>::max();
+
+    while (true) {
+        int cell = row * m_columns + column;
+        for (int k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+            int wall = m_cellWalls[k];
+            double t;
+            if (m_table->hitWall(wall, origin.x(), origin.y(), dx, dy,
+                                 minDistance, maxDistance, excludeWall, t)) {
+                // При равных расстояниях побеждает меньший индекс, как при линейном проходе
+                if (t < minFound || (t == minFound && wall < closest)) {
+                    minFound = t;
+                    closest = wall;
+                }
+            }
+        }
+
+        // Попадание ближе выхода из ячейки - в следующих ячейках ближе не будет
+        double cellExit = qMin(tMaxX, tMaxY);
+        if (closest >= 0 && minFound < cellExit) break;
+        if (cellExit > tExit) break;
+
+        if (tMaxX < tMaxY) {
+            column += stepX;
+            if (column < 0 || column >= m_columns) break;
+            tMaxX += tDeltaX;
+        } else {
+            row += stepY;
+            if (row < 0 || row >= m_rows) break;
+            tMaxY += tDeltaY;
+        }
+    }
+
+    distance = minFound;
+    return closest;
+}
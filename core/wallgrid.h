@@ -0,0 +1,39 @@
+#ifndef WALLGRID_H
+#define WALLGRID_H
+
+#include "wallindex.h"
+
+// Равномерная сетка над отрезками стен.
+// Строится один раз после завершения комнаты; луч проходит по ячейкам (2D DDA)
+// и проверяет только стены в пересеченных ячейках, а не все стены комнаты.
+class WallGrid : public WallIndex
+{
+public:
+    WallGrid();
+
+    void build(const WallTable& table) override;
+    void clear() override;
+    int findNextWall(const QPointF& origin, const QPointF& direction,
+                     double maxDistance, double minDistance, int excludeWall,
+                     double& distance) const override;
+
+    int columns() const { return m_columns; }
+    int rows() const { return m_rows; }
+
+private:
+    const WallTable* m_table;
+    QVector<int> m_cellStart;  // m_cellStart[c]..m_cellStart[c+1] - диапазон в m_cellWalls
+    QVector<int> m_cellWalls;  // индексы стен по ячейкам
+    double m_minX;
+    double m_minY;
+    double m_cellWidth;
+    double m_cellHeight;
+    int m_columns;
+    int m_rows;
+
+    bool segmentTouchesCell(int wall, int column, int row) const;
+    int columnAt(double x) const;
+    int rowAt(double y) const;
+};
+
+#endif // WALLGRID_H
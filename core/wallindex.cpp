@@ -0,0 +1,38 @@
+#include "wallindex.h"
+#include "wallbvh.h"
+#include "wallgrid.h"
+
+void WallIndex::findNextWalls(const WallKernel::RayPacket& rays,
+                              double maxDistance, double minDistance, int excludeWall,
+                              int* hitWalls, double* distances) const
+{
+    for (int lane = 0; lane < WallKernel::MaxLanes; ++lane) {
+        QPointF direction(rays.directionX[lane], rays.directionY[lane]);
+        if (direction.isNull()) {
+            hitWalls[lane] = -1;
+            continue;
+        }
+        hitWalls[lane] = findNextWall(QPointF(rays.originX[lane], rays.originY[lane]), direction,
+                                      maxDistance, minDistance, excludeWall, distances[lane]);
+    }
+}
+
+WallIndex* WallIndex::create(Backend backend)
+{
+    switch (backend) {
+    case UniformGrid: return new WallGrid();
+    case Bvh: return new WallBvh();
+    case LinearScan:
+    default: return nullptr;
+    }
+}
+
+QString WallIndex::backendName(Backend backend)
+{
+    switch (backend) {
+    case LinearScan: return "linear";
+    case UniformGrid: return "grid";
+    case Bvh: return "bvh";
+    default: return "unknown";
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef WALLINDEX_H
+#define WALLINDEX_H
+
+#include <QPointF>
+#include "walltable.h"
+
+// Ускоряющая структура для поиска следующей стены на луче.
+// Выбирается при завершении комнаты; все реализации возвращают те же попадания,
+// что и линейный проход WallTable::findNextWall.
+// Структура хранит указатель на таблицу, таблица должна жить дольше нее.
+class WallIndex
+{
+public:
+    enum Backend {
+        LinearScan,
+        UniformGrid,
+        Bvh
+    };
+
+    virtual ~WallIndex() {}
+
+    virtual void build(const WallTable& table) = 0;
+    virtual void clear() = 0;
+
+    // Индекс ближайшей стены на луче длиной maxDistance (может быть бесконечной) или -1,
+    // попадания ближе minDistance игнорируются, excludeWall - как у WallTable::hitWall
+    virtual int findNextWall(const QPointF& origin, const QPointF& direction,
+                             double maxDistance, double minDistance, int excludeWall,
+                             double& distance) const = 0;
+
+    // Поиск для пакета лучей с общей исключенной стеной; по умолчанию - по одному лучу.
+    // Дорожки с нулевым направлением пропускаются (-1)
+    virtual void findNextWalls(const WallKernel::RayPacket& rays,
+                               double maxDistance, double minDistance, int excludeWall,
+                               int* hitWalls, double* distances) const;
+
+    // Для LinearScan возвращает nullptr: LightRay перебирает стены сам
+    static WallIndex* create(Backend backend);
+    static QString backendName(Backend backend);
+};
+
+#endif // WALLINDEX_H
@@ -0,0 +1,765 @@
+#include "wallkernel.h"
+#include <limits>
+
+// Векторные ядра собираются через атрибуты target, поэтому весь проект
+// не требует флагов -mavx2/-mavx512f и запускается на любом x86-процессоре
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define WALLKERNEL_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Условия отбора попадания общие для всех ядер: стена не excludeWall,
+// t > minDistance, t <= maxDistance и строго ближе уже найденного
+template <typename Real>
+int scalarTail(const WallKernel::BasicColumns<Real>& walls, int first, int end,
+               Real ox, Real oy, Real dx, Real dy,
+               Real maxDistance, Real minDistance, int excludeWall, int closest, Real& minFound)
+{
+    for (int i = first; i < end; ++i) {
+        Real t;
+        if (i != excludeWall && WallKernel::intersect(walls, i, ox, oy, dx, dy, t)
+            && t > minDistance && t <= maxDistance && t < minFound) {
+            minFound = t;
+            closest = i;
+        }
+    }
+    return closest;
+}
+
+// Сведение дорожек: минимальное расстояние, при равенстве - меньший индекс.
+// Внутри дорожки индексы возрастают и сравнение строгое, так что результат
+// совпадает с последовательным проходом
+template <typename Real>
+int reduceLanes(const Real* lanesDistance, const Real* lanesIndex, int lanes, Real& minFound)
+{
+    int closest = -1;
+    minFound = std::numeric_limits<Real>::max();
+    for (int lane = 0; lane < lanes; ++lane) {
+        int index = int(lanesIndex[lane]);
+        if (index < 0) continue;
+        if (lanesDistance[lane] < minFound || (lanesDistance[lane] == minFound && index < closest)) {
+            minFound = lanesDistance[lane];
+            closest = index;
+        }
+    }
+    return closest;
+}
+
+template <typename Real>
+int nearestHitScalar(const WallKernel::BasicColumns<Real>& walls, int first, int count,
+                     Real ox, Real oy, Real dx, Real dy,
+                     Real maxDistance, Real minDistance, int excludeWall, Real& distance)
+{
+    distance = std::numeric_limits<Real>::max();
+    return scalarTail(walls, first, first + count, ox, oy, dx, dy,
+                      maxDistance, minDistance, excludeWall, -1, distance);
+}
+
+void nearestHitsScalar(const WallKernel::Columns& walls, int first, int count,
+                       const WallKernel::RayPacket& rays, double maxDistance, double minDistance,
+                       int excludeWall, int* hitWalls, double* distances)
+{
+    for (int lane = 0; lane < WallKernel::MaxLanes; ++lane) {
+        hitWalls[lane] = -1;
+        distances[lane] = std::numeric_limits<double>::max();
+    }
+
+    for (int i = first; i < first + count; ++i) {
+        if (i == excludeWall) continue;
+        for (int lane = 0; lane < WallKernel::MaxLanes; ++lane) {
+            double t;
+            if (WallKernel::intersect(walls, i, rays.originX[lane], rays.originY[lane],
+                                      rays.directionX[lane], rays.directionY[lane], t)
+                && t > minDistance && t <= maxDistance && t < distances[lane]) {
+                distances[lane] = t;
+                hitWalls[lane] = i;
+            }
+        }
+    }
+}
+
+#ifdef WALLKERNEL_X86
+
+// После AVX-кода обязательно vzeroupper: иначе следующий за ним SSE-код (libm, Qt)
+// платит за переход состояния на каждой инструкции; GCC с атрибутом target его не вставляет.
+// Индексы стен хранятся в дорожках как double: целые до 2^53 представимы точно,
+// а смешивание идет той же маской, что и для расстояний.
+// Луч пересекает лишь немногие стены, поэтому блоки, где ни одна стена
+// не прошла проверку параметра отрезка, пропускаются без деления
+// Ядра AVX-512 берут остаток блока маской: у них GCC держит значения в zmm16-31 и перед
+// скалярным хвостом после vzeroupper восстанавливал бы их оттуда. У AVX2 регистров старше
+// ymm15 нет, хвост после vzeroupper - чистый SSE-код, поэтому там остается scalarTail
+
+__attribute__((target("sse2")))
+int nearestHitSse2(const WallKernel::Columns& walls, int first, int count,
+                   double ox, double oy, double dx, double dy,
+                   double maxDistance, double minDistance, int excludeWall, double& distance)
+{
+    const __m128d originX = _mm_set1_pd(ox);
+    const __m128d originY = _mm_set1_pd(oy);
+    const __m128d directionX = _mm_set1_pd(dx);
+    const __m128d directionY = _mm_set1_pd(dy);
+    const __m128d minT = _mm_set1_pd(minDistance);
+    const __m128d maxT = _mm_set1_pd(maxDistance);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d step = _mm_set1_pd(2.0);
+    const __m128d excluded = _mm_set1_pd(excludeWall);
+
+    __m128d best = _mm_set1_pd(std::numeric_limits<double>::max());
+    __m128d bestIndex = _mm_set1_pd(-1.0);
+    __m128d index = _mm_setr_pd(first, first + 1);
+
+    int end = first + count;
+    int i = first;
+    for (; i + 2 <= end; i += 2) {
+        __m128d wallX = _mm_loadu_pd(walls.directionX + i);
+        __m128d wallY = _mm_loadu_pd(walls.directionY + i);
+        __m128d qx = _mm_sub_pd(_mm_loadu_pd(walls.startX + i), originX);
+        __m128d qy = _mm_sub_pd(_mm_loadu_pd(walls.startY + i), originY);
+
+        __m128d denominator = _mm_sub_pd(_mm_mul_pd(directionX, wallY), _mm_mul_pd(directionY, wallX));
+        __m128d u = _mm_mul_pd(_mm_sub_pd(_mm_mul_pd(qx, directionY), _mm_mul_pd(qy, directionX)),
+                               _mm_loadu_pd(walls.inverseLength + i));
+
+        __m128d hit = _mm_cmpneq_pd(denominator, zero);
+        hit = _mm_and_pd(hit, _mm_cmpnlt_pd(_mm_mul_pd(u, _mm_sub_pd(denominator, u)), zero));
+        hit = _mm_and_pd(hit, _mm_cmpneq_pd(index, excluded));
+        if (_mm_movemask_pd(hit) == 0) {
+            index = _mm_add_pd(index, step);
+            continue;
+        }
+
+        __m128d t = _mm_div_pd(_mm_sub_pd(_mm_mul_pd(qx, wallY), _mm_mul_pd(qy, wallX)), denominator);
+        hit = _mm_and_pd(hit, _mm_cmpgt_pd(t, minT));
+        hit = _mm_and_pd(hit, _mm_cmple_pd(t, maxT));
+        hit = _mm_and_pd(hit, _mm_cmplt_pd(t, best));
+
+        best = _mm_or_pd(_mm_and_pd(hit, t), _mm_andnot_pd(hit, best));
+        bestIndex = _mm_or_pd(_mm_and_pd(hit, index), _mm_andnot_pd(hit, bestIndex));
+        index = _mm_add_pd(index, step);
+    }
+
+    double lanesDistance[2];
+    double lanesIndex[2];
+    _mm_storeu_pd(lanesDistance, best);
+    _mm_storeu_pd(lanesIndex, bestIndex);
+
+    int closest = reduceLanes(lanesDistance, lanesIndex, 2, distance);
+    return scalarTail(walls, i, end, ox, oy, dx, dy, maxDistance, minDistance, excludeWall,
+                      closest, distance);
+}
+
+__attribute__((target("avx2")))
+int nearestHitAvx2(const WallKernel::Columns& walls, int first, int count,
+                   double ox, double oy, double dx, double dy,
+                   double maxDistance, double minDistance, int excludeWall, double& distance)
+{
+    const __m256d originX = _mm256_set1_pd(ox);
+    const __m256d originY = _mm256_set1_pd(oy);
+    const __m256d directionX = _mm256_set1_pd(dx);
+    const __m256d directionY = _mm256_set1_pd(dy);
+    const __m256d minT = _mm256_set1_pd(minDistance);
+    const __m256d maxT = _mm256_set1_pd(maxDistance);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d step = _mm256_set1_pd(4.0);
+    const __m256d excluded = _mm256_set1_pd(excludeWall);
+
+    __m256d best = _mm256_set1_pd(std::numeric_limits<double>::max());
+    __m256d bestIndex = _mm256_set1_pd(-1.0);
+    __m256d index = _mm256_setr_pd(first, first + 1, first + 2, first + 3);
+
+    int end = first + count;
+    int i = first;
+    for (; i + 4 <= end; i += 4) {
+        __m256d wallX = _mm256_loadu_pd(walls.directionX + i);
+        __m256d wallY = _mm256_loadu_pd(walls.directionY + i);
+        __m256d qx = _mm256_sub_pd(_mm256_loadu_pd(walls.startX + i), originX);
+        __m256d qy = _mm256_sub_pd(_mm256_loadu_pd(walls.startY + i), originY);
+
+        __m256d denominator = _mm256_sub_pd(_mm256_mul_pd(directionX, wallY),
+                                            _mm256_mul_pd(directionY, wallX));
+        __m256d u = _mm256_mul_pd(_mm256_sub_pd(_mm256_mul_pd(qx, directionY), _mm256_mul_pd(qy, directionX)),
+                                  _mm256_loadu_pd(walls.inverseLength + i));
+
+        __m256d hit = _mm256_cmp_pd(denominator, zero, _CMP_NEQ_UQ);
+        hit = _mm256_and_pd(hit, _mm256_cmp_pd(_mm256_mul_pd(u, _mm256_sub_pd(denominator, u)),
+                                               zero, _CMP_NLT_UQ));
+        hit = _mm256_and_pd(hit, _mm256_cmp_pd(index, excluded, _CMP_NEQ_OQ));
+        if (_mm256_movemask_pd(hit) == 0) {
+            index = _mm256_add_pd(index, step);
+            continue;
+        }
+
+        __m256d t = _mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(qx, wallY), _mm256_mul_pd(qy, wallX)),
+                                  denominator);
+        hit = _mm256_and_pd(hit, _mm256_cmp_pd(t, minT, _CMP_GT_OQ));
+        hit = _mm256_and_pd(hit, _mm256_cmp_pd(t, maxT, _CMP_LE_OQ));
+        hit = _mm256_and_pd(hit, _mm256_cmp_pd(t, best, _CMP_LT_OQ));
+
+        best = _mm256_blendv_pd(best, t, hit);
+        bestIndex = _mm256_blendv_pd(bestIndex, index, hit);
+        index = _mm256_add_pd(index, step);
+    }
+
+    double lanesDistance[4];
+    double lanesIndex[4];
+    _mm256_storeu_pd(lanesDistance, best);
+    _mm256_storeu_pd(lanesIndex, bestIndex);
+    _mm256_zeroupper();
+
+    int closest = reduceLanes(lanesDistance, lanesIndex, 4, distance);
+    return scalarTail(walls, i, end, ox, oy, dx, dy, maxDistance, minDistance, excludeWall,
+                      closest, distance);
+}
+
+__attribute__((target("avx512f")))
+int nearestHitAvx512(const WallKernel::Columns& walls, int first, int count,
+                     double ox, double oy, double dx, double dy,
+                     double maxDistance, double minDistance, int excludeWall, double& distance)
+{
+    const __m512d originX = _mm512_set1_pd(ox);
+    const __m512d originY = _mm512_set1_pd(oy);
+    const __m512d directionX = _mm512_set1_pd(dx);
+    const __m512d directionY = _mm512_set1_pd(dy);
+    const __m512d minT = _mm512_set1_pd(minDistance);
+    const __m512d maxT = _mm512_set1_pd(maxDistance);
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d step = _mm512_set1_pd(8.0);
+    const __m512d excluded = _mm512_set1_pd(excludeWall);
+
+    __m512d best = _mm512_set1_pd(std::numeric_limits<double>::max());
+    __m512d bestIndex = _mm512_set1_pd(-1.0);
+    __m512d index = _mm512_setr_pd(first, first + 1, first + 2, first + 3,
+                                   first + 4, first + 5, first + 6, first + 7);
+
+    // Остаток короче 8 дорожек - маской, как в nearestHitFloatAvx512, а не scalarTail
+    int end = first + count;
+    for (int i = first; i < end; i += 8) {
+        const __mmask8 lanes = end - i >= 8 ? __mmask8(0xFF) : __mmask8((1u << (end - i)) - 1);
+        __m512d wallX = _mm512_maskz_loadu_pd(lanes, walls.directionX + i);
+        __m512d wallY = _mm512_maskz_loadu_pd(lanes, walls.directionY + i);
+        __m512d qx = _mm512_sub_pd(_mm512_maskz_loadu_pd(lanes, walls.startX + i), originX);
+        __m512d qy = _mm512_sub_pd(_mm512_maskz_loadu_pd(lanes, walls.startY + i), originY);
+
+        __m512d denominator = _mm512_sub_pd(_mm512_mul_pd(directionX, wallY),
+                                            _mm512_mul_pd(directionY, wallX));
+        __m512d u = _mm512_mul_pd(_mm512_sub_pd(_mm512_mul_pd(qx, directionY), _mm512_mul_pd(qy, directionX)),
+                                  _mm512_maskz_loadu_pd(lanes, walls.inverseLength + i));
+
+        __mmask8 hit = lanes & _mm512_cmp_pd_mask(denominator, zero, _CMP_NEQ_UQ);
+        hit &= _mm512_cmp_pd_mask(_mm512_mul_pd(u, _mm512_sub_pd(denominator, u)), zero, _CMP_NLT_UQ);
+        hit &= _mm512_cmp_pd_mask(index, excluded, _CMP_NEQ_OQ);
+        if (hit == 0) {
+            index = _mm512_add_pd(index, step);
+            continue;
+        }
+
+        __m512d t = _mm512_div_pd(_mm512_sub_pd(_mm512_mul_pd(qx, wallY), _mm512_mul_pd(qy, wallX)),
+                                  denominator);
+        hit &= _mm512_cmp_pd_mask(t, minT, _CMP_GT_OQ);
+        hit &= _mm512_cmp_pd_mask(t, maxT, _CMP_LE_OQ);
+        hit &= _mm512_cmp_pd_mask(t, best, _CMP_LT_OQ);
+
+        best = _mm512_mask_blend_pd(hit, best, t);
+        bestIndex = _mm512_mask_blend_pd(hit, bestIndex, index);
+        index = _mm512_add_pd(index, step);
+    }
+
+    double lanesDistance[8];
+    double lanesIndex[8];
+    _mm512_storeu_pd(lanesDistance, best);
+    _mm512_storeu_pd(lanesIndex, bestIndex);
+    _mm256_zeroupper();
+
+    return reduceLanes(lanesDistance, lanesIndex, 8, distance);
+}
+
+// Пакетные ядра: дорожка - луч, стены перебираются по одной и размножаются на все дорожки.
+// Стены идут по возрастанию индекса, сравнение строгое - при равенстве остается меньший индекс
+
+__attribute__((target("sse2")))
+void nearestHitsSse2(const WallKernel::Columns& walls, int first, int count,
+                     const WallKernel::RayPacket& rays, double maxDistance, double minDistance,
+                     int excludeWall, int* hitWalls, double* distances)
+{
+    const int Groups = WallKernel::MaxLanes / 2;
+    const __m128d minT = _mm_set1_pd(minDistance);
+    const __m128d maxT = _mm_set1_pd(maxDistance);
+    const __m128d zero = _mm_setzero_pd();
+
+    __m128d originX[Groups], originY[Groups], directionX[Groups], directionY[Groups];
+    __m128d best[Groups], bestIndex[Groups];
+    for (int g = 0; g < Groups; ++g) {
+        originX[g] = _mm_loadu_pd(rays.originX + 2 * g);
+        originY[g] = _mm_loadu_pd(rays.originY + 2 * g);
+        directionX[g] = _mm_loadu_pd(rays.directionX + 2 * g);
+        directionY[g] = _mm_loadu_pd(rays.directionY + 2 * g);
+        best[g] = _mm_set1_pd(std::numeric_limits<double>::max());
+        bestIndex[g] = _mm_set1_pd(-1.0);
+    }
+
+    for (int i = first; i < first + count; ++i) {
+        if (i == excludeWall) continue;
+        const __m128d startX = _mm_set1_pd(walls.startX[i]);
+        const __m128d startY = _mm_set1_pd(walls.startY[i]);
+        const __m128d wallX = _mm_set1_pd(walls.directionX[i]);
+        const __m128d wallY = _mm_set1_pd(walls.directionY[i]);
+        const __m128d inverseLength = _mm_set1_pd(walls.inverseLength[i]);
+        const __m128d index = _mm_set1_pd(i);
+
+        for (int g = 0; g < Groups; ++g) {
+            __m128d qx = _mm_sub_pd(startX, originX[g]);
+            __m128d qy = _mm_sub_pd(startY, originY[g]);
+            __m128d denominator = _mm_sub_pd(_mm_mul_pd(directionX[g], wallY), _mm_mul_pd(directionY[g], wallX));
+            __m128d u = _mm_mul_pd(_mm_sub_pd(_mm_mul_pd(qx, directionY[g]), _mm_mul_pd(qy, directionX[g])),
+                                   inverseLength);
+
+            __m128d hit = _mm_cmpneq_pd(denominator, zero);
+            hit = _mm_and_pd(hit, _mm_cmpnlt_pd(_mm_mul_pd(u, _mm_sub_pd(denominator, u)), zero));
+            if (_mm_movemask_pd(hit) == 0) continue;
+
+            __m128d t = _mm_div_pd(_mm_sub_pd(_mm_mul_pd(qx, wallY), _mm_mul_pd(qy, wallX)), denominator);
+            hit = _mm_and_pd(hit, _mm_cmpgt_pd(t, minT));
+            hit = _mm_and_pd(hit, _mm_cmple_pd(t, maxT));
+            hit = _mm_and_pd(hit, _mm_cmplt_pd(t, best[g]));
+
+            best[g] = _mm_or_pd(_mm_and_pd(hit, t), _mm_andnot_pd(hit, best[g]));
+            bestIndex[g] = _mm_or_pd(_mm_and_pd(hit, index), _mm_andnot_pd(hit, bestIndex[g]));
+        }
+    }
+
+    double lanesIndex[WallKernel::MaxLanes];
+    for (int g = 0; g < Groups; ++g) {
+        _mm_storeu_pd(distances + 2 * g, best[g]);
+        _mm_storeu_pd(lanesIndex + 2 * g, bestIndex[g]);
+    }
+    for (int lane = 0; lane < WallKernel::MaxLanes; ++lane) {
+        hitWalls[lane] = int(lanesIndex[lane]);
+    }
+}
+
+__attribute__((target("avx2")))
+void nearestHitsAvx2(const WallKernel::Columns& walls, int first, int count,
+                     const WallKernel::RayPacket& rays, double maxDistance, double minDistance,
+                     int excludeWall, int* hitWalls, double* distances)
+{
+    const int Groups = WallKernel::MaxLanes / 4;
+    const __m256d minT = _mm256_set1_pd(minDistance);
+    const __m256d maxT = _mm256_set1_pd(maxDistance);
+    const __m256d zero = _mm256_setzero_pd();
+
+    __m256d originX[Groups], originY[Groups], directionX[Groups], directionY[Groups];
+    __m256d best[Groups], bestIndex[Groups];
+    for (int g = 0; g < Groups; ++g) {
+        originX[g] = _mm256_loadu_pd(rays.originX + 4 * g);
+        originY[g] = _mm256_loadu_pd(rays.originY + 4 * g);
+        directionX[g] = _mm256_loadu_pd(rays.directionX + 4 * g);
+        directionY[g] = _mm256_loadu_pd(rays.directionY + 4 * g);
+        best[g] = _mm256_set1_pd(std::numeric_limits<double>::max());
+        bestIndex[g] = _mm256_set1_pd(-1.0);
+    }
+
+    for (int i = first; i < first + count; ++i) {
+        if (i == excludeWall) continue;
+        const __m256d startX = _mm256_set1_pd(walls.startX[i]);
+        const __m256d startY = _mm256_set1_pd(walls.startY[i]);
+        const __m256d wallX = _mm256_set1_pd(walls.directionX[i]);
+        const __m256d wallY = _mm256_set1_pd(walls.directionY[i]);
+        const __m256d inverseLength = _mm256_set1_pd(walls.inverseLength[i]);
+        const __m256d index = _mm256_set1_pd(i);
+
+        for (int g = 0; g < Groups; ++g) {
+            __m256d qx = _mm256_sub_pd(startX, originX[g]);
+            __m256d qy = _mm256_sub_pd(startY, originY[g]);
+            __m256d denominator = _mm256_sub_pd(_mm256_mul_pd(directionX[g], wallY),
+                                                _mm256_mul_pd(directionY[g], wallX));
+            __m256d u = _mm256_mul_pd(_mm256_sub_pd(_mm256_mul_pd(qx, directionY[g]),
+                                                    _mm256_mul_pd(qy, directionX[g])),
+                                      inverseLength);
+
+            __m256d hit = _mm256_cmp_pd(denominator, zero, _CMP_NEQ_UQ);
+            hit = _mm256_and_pd(hit, _mm256_cmp_pd(_mm256_mul_pd(u, _mm256_sub_pd(denominator, u)),
+                                                   zero, _CMP_NLT_UQ));
+            if (_mm256_movemask_pd(hit) == 0) continue;
+
+            __m256d t = _mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(qx, wallY), _mm256_mul_pd(qy, wallX)),
+                                      denominator);
+            hit = _mm256_and_pd(hit, _mm256_cmp_pd(t, minT, _CMP_GT_OQ));
+            hit = _mm256_and_pd(hit, _mm256_cmp_pd(t, maxT, _CMP_LE_OQ));
+            hit = _mm256_and_pd(hit, _mm256_cmp_pd(t, best[g], _CMP_LT_OQ));
+
+            best[g] = _mm256_blendv_pd(best[g], t, hit);
+            bestIndex[g] = _mm256_blendv_pd(bestIndex[g], index, hit);
+        }
+    }
+
+    double lanesIndex[WallKernel::MaxLanes];
+    for (int g = 0; g < Groups; ++g) {
+        _mm256_storeu_pd(distances + 4 * g, best[g]);
+        _mm256_storeu_pd(lanesIndex + 4 * g, bestIndex[g]);
+    }
+    _mm256_zeroupper();
+    for (int lane = 0; lane < WallKernel::MaxLanes; ++lane) {
+        hitWalls[lane] = int(lanesIndex[lane]);
+    }
+}
+
+__attribute__((target("avx512f")))
+void nearestHitsAvx512(const WallKernel::Columns& walls, int first, int count,
+                       const WallKernel::RayPacket& rays, double maxDistance, double minDistance,
+                       int excludeWall, int* hitWalls, double* distances)
+{
+    const __m512d minT = _mm512_set1_pd(minDistance);
+    const __m512d maxT = _mm512_set1_pd(maxDistance);
+    const __m512d zero = _mm512_setzero_pd();
+
+    const __m512d originX = _mm512_loadu_pd(rays.originX);
+    const __m512d originY = _mm512_loadu_pd(rays.originY);
+    const __m512d directionX = _mm512_loadu_pd(rays.directionX);
+    const __m512d directionY = _mm512_loadu_pd(rays.directionY);
+    __m512d best = _mm512_set1_pd(std::numeric_limits<double>::max());
+    __m512d bestIndex = _mm512_set1_pd(-1.0);
+
+    for (int i = first; i < first + count; ++i) {
+        if (i == excludeWall) continue;
+        const __m512d wallX = _mm512_set1_pd(walls.directionX[i]);
+        const __m512d wallY = _mm512_set1_pd(walls.directionY[i]);
+        __m512d qx = _mm512_sub_pd(_mm512_set1_pd(walls.startX[i]), originX);
+        __m512d qy = _mm512_sub_pd(_mm512_set1_pd(walls.startY[i]), originY);
+
+        __m512d denominator = _mm512_sub_pd(_mm512_mul_pd(directionX, wallY),
+                                            _mm512_mul_pd(directionY, wallX));
+        __m512d u = _mm512_mul_pd(_mm512_sub_pd(_mm512_mul_pd(qx, directionY), _mm512_mul_pd(qy, directionX)),
+                                  _mm512_set1_pd(walls.inverseLength[i]));
+
+        __mmask8 hit = _mm512_cmp_pd_mask(denominator, zero, _CMP_NEQ_UQ);
+        hit &= _mm512_cmp_pd_mask(_mm512_mul_pd(u, _mm512_sub_pd(denominator, u)), zero, _CMP_NLT_UQ);
+        if (hit == 0) continue;
+
+        __m512d t = _mm512_div_pd(_mm512_sub_pd(_mm512_mul_pd(qx, wallY), _mm512_mul_pd(qy, wallX)),
+                                  denominator);
+        hit &= _mm512_cmp_pd_mask(t, minT, _CMP_GT_OQ);
+        hit &= _mm512_cmp_pd_mask(t, maxT, _CMP_LE_OQ);
+        hit &= _mm512_cmp_pd_mask(t, best, _CMP_LT_OQ);
+
+        best = _mm512_mask_blend_pd(hit, best, t);
+        bestIndex = _mm512_mask_blend_pd(hit, bestIndex, _mm512_set1_pd(i));
+    }
+
+    double lanesIndex[WallKernel::MaxLanes];
+    _mm512_storeu_pd(distances, best);
+    _mm512_storeu_pd(lanesIndex, bestIndex);
+    _mm256_zeroupper();
+    for (int lane = 0; lane < WallKernel::MaxLanes; ++lane) {
+        hitWalls[lane] = int(lanesIndex[lane]);
+    }
+}
+
+// Одинарная точность: те же выражения над float, вдвое больше стен за инструкцию
+
+__attribute__((target("sse2")))
+int nearestHitFloatSse2(const WallKernel::FloatColumns& walls, int first, int count,
+                        float ox, float oy, float dx, float dy,
+                        float maxDistance, float minDistance, int excludeWall, float& distance)
+{
+    const __m128 originX = _mm_set1_ps(ox);
+    const __m128 originY = _mm_set1_ps(oy);
+    const __m128 directionX = _mm_set1_ps(dx);
+    const __m128 directionY = _mm_set1_ps(dy);
+    const __m128 minT = _mm_set1_ps(minDistance);
+    const __m128 maxT = _mm_set1_ps(maxDistance);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 step = _mm_set1_ps(4.0f);
+    const __m128 excluded = _mm_set1_ps(excludeWall);
+
+    __m128 best = _mm_set1_ps(std::numeric_limits<float>::max());
+    __m128 bestIndex = _mm_set1_ps(-1.0f);
+    __m128 index = _mm_setr_ps(first, first + 1, first + 2, first + 3);
+
+    int end = first + count;
+    int i = first;
+    for (; i + 4 <= end; i += 4) {
+        __m128 wallX = _mm_loadu_ps(walls.directionX + i);
+        __m128 wallY = _mm_loadu_ps(walls.directionY + i);
+        __m128 qx = _mm_sub_ps(_mm_loadu_ps(walls.startX + i), originX);
+        __m128 qy = _mm_sub_ps(_mm_loadu_ps(walls.startY + i), originY);
+
+        __m128 denominator = _mm_sub_ps(_mm_mul_ps(directionX, wallY), _mm_mul_ps(directionY, wallX));
+        __m128 u = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(qx, directionY), _mm_mul_ps(qy, directionX)),
+                              _mm_loadu_ps(walls.inverseLength + i));
+
+        __m128 hit = _mm_cmpneq_ps(denominator, zero);
+        hit = _mm_and_ps(hit, _mm_cmpnlt_ps(_mm_mul_ps(u, _mm_sub_ps(denominator, u)), zero));
+        hit = _mm_and_ps(hit, _mm_cmpneq_ps(index, excluded));
+        if (_mm_movemask_ps(hit) == 0) {
+            index = _mm_add_ps(index, step);
+            continue;
+        }
+
+        __m128 t = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(qx, wallY), _mm_mul_ps(qy, wallX)), denominator);
+        hit = _mm_and_ps(hit, _mm_cmpgt_ps(t, minT));
+        hit = _mm_and_ps(hit, _mm_cmple_ps(t, maxT));
+        hit = _mm_and_ps(hit, _mm_cmplt_ps(t, best));
+
+        best = _mm_or_ps(_mm_and_ps(hit, t), _mm_andnot_ps(hit, best));
+        bestIndex = _mm_or_ps(_mm_and_ps(hit, index), _mm_andnot_ps(hit, bestIndex));
+        index = _mm_add_ps(index, step);
+    }
+
+    float lanesDistance[4];
+    float lanesIndex[4];
+    _mm_storeu_ps(lanesDistance, best);
+    _mm_storeu_ps(lanesIndex, bestIndex);
+
+    int closest = reduceLanes(lanesDistance, lanesIndex, 4, distance);
+    return scalarTail(walls, i, end, ox, oy, dx, dy, maxDistance, minDistance, excludeWall,
+                      closest, distance);
+}
+
+__attribute__((target("avx2")))
+int nearestHitFloatAvx2(const WallKernel::FloatColumns& walls, int first, int count,
+                        float ox, float oy, float dx, float dy,
+                        float maxDistance, float minDistance, int excludeWall, float& distance)
+{
+    const __m256 originX = _mm256_set1_ps(ox);
+    const __m256 originY = _mm256_set1_ps(oy);
+    const __m256 directionX = _mm256_set1_ps(dx);
+    const __m256 directionY = _mm256_set1_ps(dy);
+    const __m256 minT = _mm256_set1_ps(minDistance);
+    const __m256 maxT = _mm256_set1_ps(maxDistance);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 step = _mm256_set1_ps(8.0f);
+    const __m256 excluded = _mm256_set1_ps(excludeWall);
+
+    __m256 best = _mm256_set1_ps(std::numeric_limits<float>::max());
+    __m256 bestIndex = _mm256_set1_ps(-1.0f);
+    __m256 index = _mm256_setr_ps(first, first + 1, first + 2, first + 3,
+                                  first + 4, first + 5, first + 6, first + 7);
+
+    int end = first + count;
+    int i = first;
+    for (; i + 8 <= end; i += 8) {
+        __m256 wallX = _mm256_loadu_ps(walls.directionX + i);
+        __m256 wallY = _mm256_loadu_ps(walls.directionY + i);
+        __m256 qx = _mm256_sub_ps(_mm256_loadu_ps(walls.startX + i), originX);
+        __m256 qy = _mm256_sub_ps(_mm256_loadu_ps(walls.startY + i), originY);
+
+        __m256 denominator = _mm256_sub_ps(_mm256_mul_ps(directionX, wallY), _mm256_mul_ps(directionY, wallX));
+        __m256 u = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(qx, directionY), _mm256_mul_ps(qy, directionX)),
+                                 _mm256_loadu_ps(walls.inverseLength + i));
+
+        __m256 hit = _mm256_cmp_ps(denominator, zero, _CMP_NEQ_UQ);
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_mul_ps(u, _mm256_sub_ps(denominator, u)),
+                                               zero, _CMP_NLT_UQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(index, excluded, _CMP_NEQ_OQ));
+        if (_mm256_movemask_ps(hit) == 0) {
+            index = _mm256_add_ps(index, step);
+            continue;
+        }
+
+        __m256 t = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(qx, wallY), _mm256_mul_ps(qy, wallX)),
+                                 denominator);
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, minT, _CMP_GT_OQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, maxT, _CMP_LE_OQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, best, _CMP_LT_OQ));
+
+        best = _mm256_blendv_ps(best, t, hit);
+        bestIndex = _mm256_blendv_ps(bestIndex, index, hit);
+        index = _mm256_add_ps(index, step);
+    }
+
+    float lanesDistance[8];
+    float lanesIndex[8];
+    _mm256_storeu_ps(lanesDistance, best);
+    _mm256_storeu_ps(lanesIndex, bestIndex);
+    _mm256_zeroupper();
+
+    int closest = reduceLanes(lanesDistance, lanesIndex, 8, distance);
+    return scalarTail(walls, i, end, ox, oy, dx, dy, maxDistance, minDistance, excludeWall,
+                      closest, distance);
+}
+
+__attribute__((target("avx512f")))
+int nearestHitFloatAvx512(const WallKernel::FloatColumns& walls, int first, int count,
+                          float ox, float oy, float dx, float dy,
+                          float maxDistance, float minDistance, int excludeWall, float& distance)
+{
+    const __m512 originX = _mm512_set1_ps(ox);
+    const __m512 originY = _mm512_set1_ps(oy);
+    const __m512 directionX = _mm512_set1_ps(dx);
+    const __m512 directionY = _mm512_set1_ps(dy);
+    const __m512 minT = _mm512_set1_ps(minDistance);
+    const __m512 maxT = _mm512_set1_ps(maxDistance);
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 step = _mm512_set1_ps(16.0f);
+    const __m512 excluded = _mm512_set1_ps(excludeWall);
+
+    __m512 best = _mm512_set1_ps(std::numeric_limits<float>::max());
+    __m512 bestIndex = _mm512_set1_ps(-1.0f);
+    __m512 index = _mm512_setr_ps(first, first + 1, first + 2, first + 3,
+                                  first + 4, first + 5, first + 6, first + 7,
+                                  first + 8, first + 9, first + 10, first + 11,
+                                  first + 12, first + 13, first + 14, first + 15);
+
+    // Остаток короче 16 дорожек берется маской, а не scalarTail: вызов скалярного хвоста
+    // после vzeroupper GCC предваряет восстановлением аргументов из zmm16-31,
+    // и весь следующий SSE-код снова платит за переход состояния
+    int end = first + count;
+    for (int i = first; i < end; i += 16) {
+        const __mmask16 lanes = end - i >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << (end - i)) - 1);
+        __m512 wallX = _mm512_maskz_loadu_ps(lanes, walls.directionX + i);
+        __m512 wallY = _mm512_maskz_loadu_ps(lanes, walls.directionY + i);
+        __m512 qx = _mm512_sub_ps(_mm512_maskz_loadu_ps(lanes, walls.startX + i), originX);
+        __m512 qy = _mm512_sub_ps(_mm512_maskz_loadu_ps(lanes, walls.startY + i), originY);
+
+        __m512 denominator = _mm512_sub_ps(_mm512_mul_ps(directionX, wallY), _mm512_mul_ps(directionY, wallX));
+        __m512 u = _mm512_mul_ps(_mm512_sub_ps(_mm512_mul_ps(qx, directionY), _mm512_mul_ps(qy, directionX)),
+                                 _mm512_maskz_loadu_ps(lanes, walls.inverseLength + i));
+
+        __mmask16 hit = lanes & _mm512_cmp_ps_mask(denominator, zero, _CMP_NEQ_UQ);
+        hit &= _mm512_cmp_ps_mask(_mm512_mul_ps(u, _mm512_sub_ps(denominator, u)), zero, _CMP_NLT_UQ);
+        hit &= _mm512_cmp_ps_mask(index, excluded, _CMP_NEQ_OQ);
+        if (hit == 0) {
+            index = _mm512_add_ps(index, step);
+            continue;
+        }
+
+        __m512 t = _mm512_div_ps(_mm512_sub_ps(_mm512_mul_ps(qx, wallY), _mm512_mul_ps(qy, wallX)),
+                                 denominator);
+        hit &= _mm512_cmp_ps_mask(t, minT, _CMP_GT_OQ);
+        hit &= _mm512_cmp_ps_mask(t, maxT, _CMP_LE_OQ);
+        hit &= _mm512_cmp_ps_mask(t, best, _CMP_LT_OQ);
+
+        best = _mm512_mask_blend_ps(hit, best, t);
+        bestIndex = _mm512_mask_blend_ps(hit, bestIndex, index);
+        index = _mm512_add_ps(index, step);
+    }
+
+    float lanesDistance[16];
+    float lanesIndex[16];
+    _mm512_storeu_ps(lanesDistance, best);
+    _mm512_storeu_ps(lanesIndex, bestIndex);
+    _mm256_zeroupper();
+
+    return reduceLanes(lanesDistance, lanesIndex, 16, distance);
+}
+
+#endif // WALLKERNEL_X86
+
+}
+
+WallKernel::Kind WallKernel::best()
+{
+    static const Kind kind = isSupported(Avx512) ? Avx512
+                           : isSupported(Avx2) ? Avx2
+                           : isSupported(Sse2) ? Sse2
+                           : Scalar;
+    return kind;
+}
+
+bool WallKernel::isSupported(Kind kind)
+{
+#ifdef WALLKERNEL_X86
+    __builtin_cpu_init();
+    switch (kind) {
+    case Scalar: return true;
+    case Sse2: return __builtin_cpu_supports("sse2");
+    case Avx2: return __builtin_cpu_supports("avx2");
+    case Avx512: return __builtin_cpu_supports("avx512f");
+    default: return false;
+    }
+#else
+    return kind == Scalar;
+#endif
+}
+
+QString WallKernel::name(Kind kind)
+{
+    switch (kind) {
+    case Scalar: return "scalar";
+    case Sse2: return "sse2";
+    case Avx2: return "avx2";
+    case Avx512: return "avx512";
+    default: return "unknown";
+    }
+}
+
+int WallKernel::nearestHit(Kind kind, const Columns& walls, int first, int count,
+                           const QPointF& origin, const QPointF& direction,
+                           double maxDistance, double minDistance, int excludeWall, double& distance)
+{
+    const double ox = origin.x();
+    const double oy = origin.y();
+    const double dx = direction.x();
+    const double dy = direction.y();
+
+    switch (kind) {
+#ifdef WALLKERNEL_X86
+    case Sse2:
+        return nearestHitSse2(walls, first, count, ox, oy, dx, dy,
+                              maxDistance, minDistance, excludeWall, distance);
+    case Avx2:
+        return nearestHitAvx2(walls, first, count, ox, oy, dx, dy,
+                              maxDistance, minDistance, excludeWall, distance);
+    case Avx512:
+        return nearestHitAvx512(walls, first, count, ox, oy, dx, dy,
+                                maxDistance, minDistance, excludeWall, distance);
+#endif
+    case Scalar:
+    default:
+        return nearestHitScalar(walls, first, count, ox, oy, dx, dy,
+                                maxDistance, minDistance, excludeWall, distance);
+    }
+}
+
+int WallKernel::nearestHit(Kind kind, const FloatColumns& walls, int first, int count,
+                           float originX, float originY, float directionX, float directionY,
+                           float maxDistance, float minDistance, int excludeWall, float& distance)
+{
+    switch (kind) {
+#ifdef WALLKERNEL_X86
+    case Sse2:
+        return nearestHitFloatSse2(walls, first, count, originX, originY, directionX, directionY,
+                                   maxDistance, minDistance, excludeWall, distance);
+    case Avx2:
+        return nearestHitFloatAvx2(walls, first, count, originX, originY, directionX, directionY,
+                                   maxDistance, minDistance, excludeWall, distance);
+    case Avx512:
+        return nearestHitFloatAvx512(walls, first, count, originX, originY, directionX, directionY,
+                                     maxDistance, minDistance, excludeWall, distance);
+#endif
+    case Scalar:
+    default:
+        return nearestHitScalar(walls, first, count, originX, originY, directionX, directionY,
+                                maxDistance, minDistance, excludeWall, distance);
+    }
+}
+
+void WallKernel::nearestHits(Kind kind, const Columns& walls, int first, int count,
+                             const RayPacket& rays, double maxDistance, double minDistance,
+                             int excludeWall, int* hitWalls, double* distances)
+{
+    switch (kind) {
+#ifdef WALLKERNEL_X86
+    case Sse2:
+        nearestHitsSse2(walls, first, count, rays, maxDistance, minDistance, excludeWall,
+                        hitWalls, distances);
+        break;
+    case Avx2:
+        nearestHitsAvx2(walls, first, count, rays, maxDistance, minDistance, excludeWall,
+                        hitWalls, distances);
+        break;
+    case Avx512:
+        nearestHitsAvx512(walls, first, count, rays, maxDistance, minDistance, excludeWall,
+                          hitWalls, distances);
+        break;
+#endif
+    case Scalar:
+    default:
+        nearestHitsScalar(walls, first, count, rays, maxDistance, minDistance, excludeWall,
+                          hitWalls, distances);
+        break;
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef WALLKERNEL_H
+#define WALLKERNEL_H
+
+#include <QPointF>
+#include <QString>
+
+// Ядро поиска ближайшего попадания луча в блок стен [first, first + count).
+// Скалярная версия - эталон; SSE2, AVX2 и AVX-512 проверяют 2, 4 и 8 стен
+// за инструкцию и выбираются во время выполнения по возможностям процессора.
+// Все версии вычисляют одни и те же выражения в том же порядке,
+// поэтому выбирают одинаковые стены вплоть до последнего бита расстояния.
+// Для трассировки одинарной точности есть те же ядра над float: 4, 8 и 16 стен за инструкцию.
+class WallKernel
+{
+public:
+    enum Kind {
+        Scalar,
+        Sse2,
+        Avx2,
+        Avx512
+    };
+
+    // Столбцы таблицы стен, которые читает ядро
+    template <typename Real>
+    struct BasicColumns {
+        const Real* startX;
+        const Real* startY;
+        const Real* directionX;
+        const Real* directionY;
+        const Real* inverseLength;
+    };
+    typedef BasicColumns<double> Columns;
+    typedef BasicColumns<float> FloatColumns;
+
+    // Ширина самого широкого ядра; таблица дополняет столбцы до кратного ей размера
+    static const int MaxLanes = 8;
+    // То же для float-ядер
+    static const int MaxFloatLanes = 16;
+
+    // Пакет до MaxLanes лучей, которые проверяются против каждой стены вместе.
+    // У незанятых дорожек нулевое направление - такие лучи ни с чем не пересекаются
+    struct RayPacket {
+        double originX[MaxLanes];
+        double originY[MaxLanes];
+        double directionX[MaxLanes];
+        double directionY[MaxLanes];
+    };
+
+    // Лучшее ядро для текущего процессора (определяется один раз)
+    static Kind best();
+    static bool isSupported(Kind kind);
+    static QString name(Kind kind);
+
+    // Индекс ближайшей стены с maxDistance >= t > minDistance или -1.
+    // Стена excludeWall (та, от которой луч отразился; -1 - никакая) не проверяется.
+    // При равных расстояниях выбирается меньший индекс
+    static int nearestHit(Kind kind, const Columns& walls, int first, int count,
+                          const QPointF& origin, const QPointF& direction,
+                          double maxDistance, double minDistance, int excludeWall, double& distance);
+
+    // То же для пакета: данные стены загружаются один раз на все лучи.
+    // Для каждой дорожки результат совпадает с nearestHit этого луча
+    static void nearestHits(Kind kind, const Columns& walls, int first, int count,
+                            const RayPacket& rays, double maxDistance, double minDistance,
+                            int excludeWall, int* hitWalls, double* distances);
+
+    // Одинарная точность: индексы стен в дорожках хранятся как float, поэтому стен не больше 2^24
+    static int nearestHit(Kind kind, const FloatColumns& walls, int first, int count,
+                          float originX, float originY, float directionX, float directionY,
+                          float maxDistance, float minDistance, int excludeWall, float& distance);
+
+    // Пересечение луча origin + t * direction (direction - единичный вектор) с отрезком стены i
+    template <typename Real>
+    static inline bool intersect(const BasicColumns<Real>& walls, int i, Real originX, Real originY,
+                                 Real directionX, Real directionY, Real& t);
+};
+
+template <typename Real>
+inline bool WallKernel::intersect(const BasicColumns<Real>& walls, int i, Real originX, Real originY,
+                                  Real directionX, Real directionY, Real& t)
+{
+    const Real wallX = walls.directionX[i];
+    const Real wallY = walls.directionY[i];
+
+    const Real denominator = directionX * wallY - directionY * wallX;
+    if (denominator == 0) return false; // параллельны или стена вырождена
+
+    const Real qx = walls.startX[i] - originX;
+    const Real qy = walls.startY[i] - originY;
+
+    // Параметр отрезка u, умноженный на знаменатель: 0 <= u <= 1 равносильно
+    // u * (denominator - u) >= 0 при любом знаке знаменателя. Так обходимся без деления
+    // и без ветвления по знаку; делим только для стен, которые луч действительно пересекает
+    const Real u = (qx * directionY - qy * directionX) * walls.inverseLength[i];
+    if (u * (denominator - u) < 0) return false;
+
+    t = (qx * wallY - qy * wallX) / denominator;
+    return true;
+}
+
+#endif // WALLKERNEL_H
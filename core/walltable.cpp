@@ -0,0 +1,344 @@
+#include "walltable.h"
+#include <QCryptographicHash>
+#include <QtEndian>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+// Порог расстояния трассировки относительно размера комнаты: намного больше ошибки
+// округления координат и намного меньше любой осмысленной длины
+const double WallTable::RelativeMinHitDistance = 1e-9;
+// Допуск стороны хорды относительно радиуса: конец дуги не должен теряться
+// из-за округления, иначе луч проскочит стык двух стен
+const double WallTable::ArcEndTolerance = 1e-9;
+
+namespace {
+
+int paddedSize(int count)
+{
+    return (count + WallKernel::MaxLanes - 1) / WallKernel::MaxLanes * WallKernel::MaxLanes;
+}
+}
+
+WallTable::WallTable()
+    : m_count(0)
+    , m_kernel(WallKernel::best())
+    , m_extent(1.0)
+    , m_minHitDistance(0.0)
+{
+}
+
+void WallTable::setKernel(WallKernel::Kind kind)
+{
+    m_kernel = WallKernel::isSupported(kind) ? kind : WallKernel::Scalar;
+}
+
+void WallTable::clear()
+{
+    m_count = 0;
+    m_extent = 1.0;
+    m_minHitDistance = 0.0;
+    m_startX.clear();
+    m_startY.clear();
+    m_directionX.clear();
+    m_directionY.clear();
+    m_inverseLength.clear();
+    m_normalX.clear();
+    m_normalY.clear();
+    m_endX.clear();
+    m_endY.clear();
+    m_surface.clear();
+    m_centerX.clear();
+    m_centerY.clear();
+    m_curvatureRadius.clear();
+    m_arcSide.clear();
+    m_concaveWalls.clear();
+    m_convexWalls.clear();
+    m_flatWalls.clear();
+    m_flatPosition.clear();
+    m_flatStartX.clear();
+    m_flatStartY.clear();
+    m_flatDirectionX.clear();
+    m_flatDirectionY.clear();
+    m_flatInverseLength.clear();
+}
+
+void WallTable::build(const QVector<Wall*>& walls)
+{
+    clear();
+
+    int count = walls.size();
+    int padded = paddedSize(count);
+
+    // Дополнение нулями: нулевое направление дает нулевой знаменатель, такие стены не пересекаются
+    m_count = count;
+    m_startX.fill(0.0, padded);
+    m_startY.fill(0.0, padded);
+    m_directionX.fill(0.0, padded);
+    m_directionY.fill(0.0, padded);
+    m_inverseLength.fill(0.0, padded);
+    m_normalX.resize(count);
+    m_normalY.resize(count);
+    m_endX.resize(count);
+    m_endY.resize(count);
+    m_surface.resize(count);
+    m_centerX.fill(0.0, count);
+    m_centerY.fill(0.0, count);
+    m_curvatureRadius.fill(0.0, count);
+    m_arcSide.fill(0.0, count);
+
+    for (int i = 0; i < count; ++i) {
+        const Wall* wall = walls[i];
+        QLineF line = wall->line();
+        double length = line.length();
+        double inverseLength = length > 0.0 ? 1.0 / length : 0.0;
+
+        m_startX[i] = line.x1();
+        m_startY[i] = line.y1();
+        m_directionX[i] = line.dx() * inverseLength;
+        m_directionY[i] = line.dy() * inverseLength;
+        m_inverseLength[i] = inverseLength;
+        m_normalX[i] = m_directionY[i];
+        m_normalY[i] = -m_directionX[i];
+        m_endX[i] = line.x2();
+        m_endY[i] = line.y2();
+
+        if (!wall->isArc()) {
+            m_surface[i] = FlatSurface;
+            continue;
+        }
+
+        m_surface[i] = wall->sphericalType() == Wall::Concave ? ConcaveSurface : ConvexSurface;
+        QPointF center = wall->curvatureCenter();
+        m_centerX[i] = center.x();
+        m_centerY[i] = center.y();
+        m_curvatureRadius[i] = wall->curvatureRadius();
+        // Центр вогнутой стены со стороны нормали, значит дуга - с противоположной
+        m_arcSide[i] = m_surface[i] == ConcaveSurface ? -1.0 : 1.0;
+        if (m_surface[i] == ConcaveSurface) {
+            m_concaveWalls.append(i);
+        } else {
+            m_convexWalls.append(i);
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        QRectF rect = bounds(i);
+        m_extent = qMax(m_extent, qMax(qMax(std::abs(rect.left()), std::abs(rect.right())),
+                                       qMax(std::abs(rect.top()), std::abs(rect.bottom()))));
+    }
+    m_minHitDistance = m_extent * RelativeMinHitDistance;
+
+    if (!hasArcs()) return;
+
+    // Сжатая копия плоских стен для векторного ядра
+    m_flatPosition.fill(-1, count);
+    for (int i = 0; i < count; ++i) {
+        if (m_surface[i] != FlatSurface) continue;
+        m_flatPosition[i] = m_flatWalls.size();
+        m_flatWalls.append(i);
+    }
+
+    int flatPadded = paddedSize(m_flatWalls.size());
+    m_flatStartX.fill(0.0, flatPadded);
+    m_flatStartY.fill(0.0, flatPadded);
+    m_flatDirectionX.fill(0.0, flatPadded);
+    m_flatDirectionY.fill(0.0, flatPadded);
+    m_flatInverseLength.fill(0.0, flatPadded);
+
+    for (int k = 0; k < m_flatWalls.size(); ++k) {
+        int i = m_flatWalls[k];
+        m_flatStartX[k] = m_startX[i];
+        m_flatStartY[k] = m_startY[i];
+        m_flatDirectionX[k] = m_directionX[i];
+        m_flatDirectionY[k] = m_directionY[i];
+        m_flatInverseLength[k] = m_inverseLength[i];
+    }
+}
+
+QByteArray WallTable::hash() const
+{
+    // Числа - битами в little-endian, чтобы хэш не зависел от машины
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    auto add = [&hash](double value) {
+        quint64 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        bits = qToLittleEndian(bits);
+        hash.addData(QByteArray(reinterpret_cast<const char*>(&bits), sizeof(bits)));
+    };
+
+    for (int i = 0; i < m_count; ++i) {
+        add(m_startX[i]);
+        add(m_startY[i]);
+        add(m_endX[i]);
+        add(m_endY[i]);
+        add(m_surface[i]);
+        add(m_curvatureRadius[i]);
+    }
+    return hash.result();
+}
+
+QPointF WallTable::normalAt(int i, const QPointF& point) const
+{
+    if (m_surface[i] == FlatSurface) return normal(i);
+
+    // Делим на фактическое расстояние, а не на радиус: точка попадания лежит
+    // на окружности лишь с точностью округления, а направление луча должно остаться единичным
+    QPointF radial = point - QPointF(m_centerX[i], m_centerY[i]);
+    return radial / std::hypot(radial.x(), radial.y());
+}
+
+QRectF WallTable::bounds(int i) const
+{
+    QPointF a = startPoint(i);
+    QPointF b = endPoint(i);
+    double minX = qMin(a.x(), b.x());
+    double minY = qMin(a.y(), b.y());
+    double maxX = qMax(a.x(), b.x());
+    double maxY = qMax(a.y(), b.y());
+
+    if (m_surface[i] != FlatSurface) {
+        // Крайние по осям точки окружности, если они лежат на дуге
+        double radius = m_curvatureRadius[i];
+        QPointF center(m_centerX[i], m_centerY[i]);
+        const QPointF extremes[4] = {center + QPointF(radius, 0), center - QPointF(radius, 0),
+                                     center + QPointF(0, radius), center - QPointF(0, radius)};
+        for (const QPointF& p : extremes) {
+            double side = ((p.x() - a.x()) * m_normalX[i] + (p.y() - a.y()) * m_normalY[i]) * m_arcSide[i];
+            if (side < 0.0) continue;
+            minX = qMin(minX, p.x());
+            minY = qMin(minY, p.y());
+            maxX = qMax(maxX, p.x());
+            maxY = qMax(maxY, p.y());
+        }
+    }
+
+    return QRectF(QPointF(minX, minY), QPointF(maxX, maxY));
+}
+
+template <WallTable::Surface S>
+bool WallTable::intersectArc(int i, double originX, double originY, double directionX, double directionY,
+                             double minDistance, double maxDistance, bool farOnly, double& t) const
+{
+    const double radius = m_curvatureRadius[i];
+    const double cx = originX - m_centerX[i];
+    const double cy = originY - m_centerY[i];
+
+    // t^2 + 2bt + c = 0 для единичного направления
+    const double b = cx * directionX + cy * directionY;
+    const double c = cx * cx + cy * cy - radius * radius;
+    const double discriminant = b * b - c;
+    if (discriminant < 0.0) return false;
+
+    // Устойчивая форма корней: без вычитания близких чисел, когда начало луча на окружности.
+    // q - больший по модулю корень; луч, вышедший с самой дуги, может попасть только в него
+    const double q = -(b + std::copysign(std::sqrt(discriminant), b));
+    double roots[2] = {q, q != 0.0 ? c / q : 0.0};
+    int rootCount = 2;
+    if (farOnly) {
+        rootCount = 1;
+    } else if (roots[0] > roots[1]) {
+        std::swap(roots[0], roots[1]);
+    }
+
+    const double qx = originX - m_startX[i];
+    const double qy = originY - m_startY[i];
+
+    for (int k = 0; k < rootCount; ++k) {
+        double root = roots[k];
+        if (root <= minDistance || root > maxDistance) continue;
+
+        // Точка окружности лежит на дуге, если она по нужную сторону хорды:
+        // у вогнутой - против нормали, у выпуклой - по ней (см. m_arcSide)
+        double side = (qx + directionX * root) * m_normalX[i] + (qy + directionY * root) * m_normalY[i];
+        if (S == ConcaveSurface) side = -side;
+        if (side >= -ArcEndTolerance * radius) {
+            t = root;
+            return true;
+        }
+    }
+    return false;
+}
+
+template bool WallTable::intersectArc<WallTable::ConcaveSurface>(int, double, double, double, double,
+                                                                 double, double, bool, double&) const;
+template bool WallTable::intersectArc<WallTable::ConvexSurface>(int, double, double, double, double,
+                                                                double, double, bool, double&) const;
+
+template <WallTable::Surface S>
+void WallTable::nearestArc(const QVector<int>& walls, double originX, double originY,
+                           double directionX, double directionY, double minDistance, double maxDistance,
+                           int excludeWall, int& closest, double& distance) const
+{
+    for (int i : walls) {
+        double t;
+        if (intersectArc<S>(i, originX, originY, directionX, directionY, minDistance, maxDistance,
+                            i == excludeWall, t)
+            && (closest < 0 || t < distance || (t == distance && i < closest))) {
+            distance = t;
+            closest = i;
+        }
+    }
+}
+
+WallKernel::Columns WallTable::kernelColumns() const
+{
+    if (!hasArcs()) return columns();
+    return {m_flatStartX.constData(), m_flatStartY.constData(), m_flatDirectionX.constData(),
+            m_flatDirectionY.constData(), m_flatInverseLength.constData()};
+}
+
+int WallTable::kernelSize() const
+{
+    return hasArcs() ? m_flatStartX.size() : m_startX.size();
+}
+
+int WallTable::kernelExclude(int excludeWall) const
+{
+    if (!hasArcs() || excludeWall < 0) return excludeWall;
+    return m_flatPosition[excludeWall];
+}
+
+int WallTable::findNextWall(const QPointF& origin, const QPointF& direction,
+                            double maxDistance, double minDistance, int excludeWall, double& distance) const
+{
+    int closest = WallKernel::nearestHit(m_kernel, kernelColumns(), 0, kernelSize(), origin, direction,
+                                         maxDistance, minDistance, kernelExclude(excludeWall), distance);
+    if (!hasArcs()) return closest;
+
+    if (closest >= 0) closest = m_flatWalls[closest];
+
+    // Дуги; при равных расстояниях побеждает меньший индекс, как в ядре
+    nearestArc<ConcaveSurface>(m_concaveWalls, origin.x(), origin.y(), direction.x(), direction.y(),
+                               minDistance, maxDistance, excludeWall, closest, distance);
+    nearestArc<ConvexSurface>(m_convexWalls, origin.x(), origin.y(), direction.x(), direction.y(),
+                              minDistance, maxDistance, excludeWall, closest, distance);
+    return closest;
+}
+
+int WallTable::findNextFlatWall(const QPointF& origin, const QPointF& direction,
+                                double maxDistance, double minDistance, int excludeWall, double& distance) const
+{
+    return WallKernel::nearestHit(m_kernel, columns(), 0, m_startX.size(), origin, direction,
+                                  maxDistance, minDistance, excludeWall, distance);
+}
+
+void WallTable::findNextWalls(const WallKernel::RayPacket& rays, double maxDistance, double minDistance,
+                              int excludeWall, int* hitWalls, double* distances) const
+{
+    WallKernel::nearestHits(m_kernel, kernelColumns(), 0, kernelSize(), rays,
+                            maxDistance, minDistance, kernelExclude(excludeWall), hitWalls, distances);
+    if (!hasArcs()) return;
+
+    for (int lane = 0; lane < WallKernel::MaxLanes; ++lane) {
+        if (rays.directionX[lane] == 0.0 && rays.directionY[lane] == 0.0) continue;
+        if (hitWalls[lane] >= 0) hitWalls[lane] = m_flatWalls[hitWalls[lane]];
+
+        nearestArc<ConcaveSurface>(m_concaveWalls, rays.originX[lane], rays.originY[lane],
+                                   rays.directionX[lane], rays.directionY[lane], minDistance, maxDistance,
+                                   excludeWall, hitWalls[lane], distances[lane]);
+        nearestArc<ConvexSurface>(m_convexWalls, rays.originX[lane], rays.originY[lane],
+                                  rays.directionX[lane], rays.directionY[lane], minDistance, maxDistance,
+                                  excludeWall, hitWalls[lane], distances[lane]);
+    }
+}
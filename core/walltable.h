@@ -0,0 +1,180 @@
+#ifndef WALLTABLE_H
+#define WALLTABLE_H
+
+#include <QByteArray>
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+#include "wall.h"
+#include "wallkernel.h"
+
+// Неизменяемая таблица стен только для трассировки.
+// Поля хранятся в отдельных непрерывных массивах (structure of arrays),
+// чтобы поиск следующей стены шел по памяти подряд, а не по указателям на Wall.
+// Таблица строится заново при изменении стен.
+// Столбцы, которые читает ядро поиска, дополнены вырожденными стенами
+// до кратного WallKernel::MaxLanes размера, чтобы векторные ядра шли без хвоста.
+// Сферические стены - точные дуги: центр и радиус кривизны считаются при построении,
+// векторное ядро проходит только по плоским стенам, дуги проверяются после него.
+// Стены разложены по типу зеркала: у каждого типа свое пересечение, выбранное
+// при компиляции (параметр шаблона Surface), так что внутри прохода тип не проверяется.
+// Комната без дуг идет веткой findNextFlatWall(), где дуг нет вовсе.
+class WallTable
+{
+public:
+    enum Surface {
+        FlatSurface,
+        ConcaveSurface,
+        ConvexSurface
+    };
+
+    // Допуски относительно размера комнаты и радиуса дуги, см. minHitDistance() и hitWall()
+    static const double RelativeMinHitDistance;
+    static const double ArcEndTolerance;
+
+    WallTable();
+
+    void build(const QVector<Wall*>& walls);
+    void clear();
+
+    int size() const { return m_count; }
+    bool isEmpty() const { return m_count == 0; }
+    // Есть ли сферические стены; без них трассировка берет плоские ветки
+    bool hasArcs() const { return !m_concaveWalls.isEmpty() || !m_convexWalls.isEmpty(); }
+
+    // Ядро линейного прохода; по умолчанию WallKernel::best()
+    WallKernel::Kind kernel() const { return m_kernel; }
+    void setKernel(WallKernel::Kind kind);
+
+    // Пересечение луча origin + t * direction (direction - единичный вектор) с хордой стены i.
+    // true, если луч пересекает отрезок; t - расстояние вдоль луча до точки пересечения
+    inline bool intersect(int i, double originX, double originY,
+                          double directionX, double directionY, double& t) const;
+
+    // Попадание в стену i с maxDistance >= t > minDistance:
+    // в отрезок для плоской стены, в ближайшую точку дуги для сферической.
+    // Если i == excludeWall, луч только что отразился от этой стены: плоская стена
+    // пропускается, у дуги остается лишь дальняя точка окружности (вогнутое зеркало
+    // может поймать луч повторно)
+    inline bool hitWall(int i, double originX, double originY, double directionX, double directionY,
+                        double minDistance, double maxDistance, int excludeWall, double& t) const;
+
+    // Линейный проход по всем стенам выбранным ядром: индекс ближайшей стены
+    // с maxDistance >= t > minDistance или -1, excludeWall - как у hitWall.
+    // При равных расстояниях выбирается меньший индекс.
+    int findNextWall(const QPointF& origin, const QPointF& direction,
+                     double maxDistance, double minDistance, int excludeWall, double& distance) const;
+    // То же только по векторному ядру, для комнаты без дуг (hasArcs() == false)
+    int findNextFlatWall(const QPointF& origin, const QPointF& direction,
+                         double maxDistance, double minDistance, int excludeWall, double& distance) const;
+
+    // То же для пакета лучей с общей исключенной стеной;
+    // результат для каждой дорожки совпадает с findNextWall
+    void findNextWalls(const WallKernel::RayPacket& rays, double maxDistance, double minDistance,
+                       int excludeWall, int* hitWalls, double* distances) const;
+
+    // Порог расстояния для трассировки: защищает от нулевых шагов между совпадающими
+    // стенами и в углах. Пропорционален размеру комнаты и на геометрию не влияет
+    double minHitDistance() const { return m_minHitDistance; }
+    // Наибольшая по модулю координата стен, не меньше 1
+    double extent() const { return m_extent; }
+
+    // SHA-256 геометрии стен: концы, тип и радиус в порядке таблицы.
+    // Совпадает у комнат, на которых трассировка дает одинаковые пути
+    QByteArray hash() const;
+
+    QPointF startPoint(int i) const { return QPointF(m_startX[i], m_startY[i]); }
+    QPointF endPoint(int i) const { return QPointF(m_endX[i], m_endY[i]); }
+    QPointF direction(int i) const { return QPointF(m_directionX[i], m_directionY[i]); }
+    QPointF normal(int i) const { return QPointF(m_normalX[i], m_normalY[i]); }
+    double inverseLength(int i) const { return m_inverseLength[i]; }
+    Surface surface(int i) const { return Surface(m_surface[i]); }
+    QPointF curvatureCenter(int i) const { return QPointF(m_centerX[i], m_centerY[i]); }
+    double curvatureRadius(int i) const { return m_curvatureRadius[i]; }
+
+    // Единичная нормаль в точке стены: у дуги - вдоль радиуса
+    QPointF normalAt(int i, const QPointF& point) const;
+    // Охватывающий прямоугольник стены вместе с выпуклостью дуги
+    QRectF bounds(int i) const;
+
+private:
+    int m_count;
+    WallKernel::Kind m_kernel;
+    double m_extent;
+    double m_minHitDistance;
+
+    QVector<double> m_startX;
+    QVector<double> m_startY;
+    QVector<double> m_directionX;    // единичное направление от начала к концу
+    QVector<double> m_directionY;
+    QVector<double> m_inverseLength; // 0 для вырожденных стен нулевой длины
+    QVector<double> m_normalX;       // единичная нормаль хорды, как у QLineF::normalVector()
+    QVector<double> m_normalY;
+    QVector<double> m_endX;          // концы стен как заданы, без пересчета через направление
+    QVector<double> m_endY;
+    QVector<quint8> m_surface;
+
+    // Дуги: центр и радиус кривизны; arcSide - сторона хорды относительно нормали,
+    // на которой лежит дуга (+1 или -1). У плоских стен радиус 0
+    QVector<double> m_centerX;
+    QVector<double> m_centerY;
+    QVector<double> m_curvatureRadius;
+    QVector<double> m_arcSide;
+    QVector<int> m_concaveWalls;
+    QVector<int> m_convexWalls;
+
+    // Если есть дуги, ядро идет по сжатой копии плоских стен; m_flatWalls[k] - номер стены,
+    // m_flatPosition[i] - место стены в копии или -1 для дуги
+    QVector<int> m_flatWalls;
+    QVector<int> m_flatPosition;
+    QVector<double> m_flatStartX;
+    QVector<double> m_flatStartY;
+    QVector<double> m_flatDirectionX;
+    QVector<double> m_flatDirectionY;
+    QVector<double> m_flatInverseLength;
+
+    WallKernel::Columns columns() const;
+    WallKernel::Columns kernelColumns() const;
+    int kernelSize() const;
+    int kernelExclude(int excludeWall) const;
+
+    // Пересечение с дугой типа S (ConcaveSurface или ConvexSurface)
+    template <Surface S>
+    bool intersectArc(int i, double originX, double originY, double directionX, double directionY,
+                      double minDistance, double maxDistance, bool farOnly, double& t) const;
+    // Ближайшая из дуг walls типа S, если она ближе closest; при равенстве - меньший индекс
+    template <Surface S>
+    void nearestArc(const QVector<int>& walls, double originX, double originY,
+                    double directionX, double directionY, double minDistance, double maxDistance,
+                    int excludeWall, int& closest, double& distance) const;
+};
+
+inline bool WallTable::intersect(int i, double originX, double originY,
+                                 double directionX, double directionY, double& t) const
+{
+    return WallKernel::intersect(columns(), i, originX, originY, directionX, directionY, t);
+}
+
+inline bool WallTable::hitWall(int i, double originX, double originY, double directionX, double directionY,
+                               double minDistance, double maxDistance, int excludeWall, double& t) const
+{
+    switch (m_surface[i]) {
+    case ConcaveSurface:
+        return intersectArc<ConcaveSurface>(i, originX, originY, directionX, directionY,
+                                            minDistance, maxDistance, i == excludeWall, t);
+    case ConvexSurface:
+        return intersectArc<ConvexSurface>(i, originX, originY, directionX, directionY,
+                                           minDistance, maxDistance, i == excludeWall, t);
+    default:
+        return i != excludeWall && intersect(i, originX, originY, directionX, directionY, t)
+               && t > minDistance && t <= maxDistance;
+    }
+}
+
+inline WallKernel::Columns WallTable::columns() const
+{
+    return {m_startX.constData(), m_startY.constData(), m_directionX.constData(),
+            m_directionY.constData(), m_inverseLength.constData()};
+}
+
+#endif // WALLTABLE_H
@@ -1,134 +0,0 @@
-/****************************************************************************
-** Meta object code from reading C++ file 'walldialog.h'
-**
-** Created by: The Qt Meta Object Compiler version 69 (Qt 6.9.0)
-**
-** WARNING! All changes made in this file will be lost!
-*****************************************************************************/
-
-#include "../walldialog.h"
-#include <QtGui/qtextcursor.h>
-#include <QtCore/qmetatype.h>
-
-#include <QtCore/qtmochelpers.h>
-
-#include <memory>
-
-
-#include <QtCore/qxptype_traits.h>
-#if !defined(Q_MOC_OUTPUT_REVISION)
-#error "The header file 'walldialog.h' doesn't include <QObject>."
-#elif Q_MOC_OUTPUT_REVISION != 69
-#error "This file was generated using the moc from 6.9.0. It"
-#error "cannot be used with the include files from this version of Qt."
-#error "(The moc has changed too much.)"
-#endif
-
-#ifndef Q_CONSTINIT
-#define Q_CONSTINIT
-#endif
-
-QT_WARNING_PUSH
-QT_WARNING_DISABLE_DEPRECATED
-QT_WARNING_DISABLE_GCC("-Wuseless-cast")
-namespace {
-struct qt_meta_tag_ZN10WallDialogE_t {};
-} // unnamed namespace
-
-template <> constexpr inline auto WallDialog::qt_create_metaobjectdata<qt_meta_tag_ZN10WallDialogE_t>()
-{
-    namespace QMC = QtMocConstants;
-    QtMocHelpers::StringRefStorage qt_stringData {
-        "WallDialog",
-        "wallConfigurationChanged",
-        "",
-        "onMirrorTypeChanged",
-        "index",
-        "applyChanges",
-        "updateWallPreview"
-    };
-
-    QtMocHelpers::UintData qt_methods {
-        // Signal 'wallConfigurationChanged'
-        QtMocHelpers::SignalData<void()>(1, 2, QMC::AccessPublic, QMetaType::Void),
-        // Slot 'onMirrorTypeChanged'
-        QtMocHelpers::SlotData<void(int)>(3, 2, QMC::AccessPrivate, QMetaType::Void, {{
-            { QMetaType::Int, 4 },
-        }}),
-        // Slot 'applyChanges'
-        QtMocHelpers::SlotData<void()>(5, 2, QMC::AccessPrivate, QMetaType::Void),
-        // Slot 'updateWallPreview'
-        QtMocHelpers::SlotData<void()>(6, 2, QMC::AccessPrivate, QMetaType::Void),
-    };
-    QtMocHelpers::UintData qt_properties {
-    };
-    QtMocHelpers::UintData qt_enums {
-    };
-    return QtMocHelpers::metaObjectData<WallDialog, qt_meta_tag_ZN10WallDialogE_t>(QMC::MetaObjectFlag{}, qt_stringData,
-            qt_methods, qt_properties, qt_enums);
-}
-Q_CONSTINIT const QMetaObject WallDialog::staticMetaObject = { {
-    QMetaObject::SuperData::link<QDialog::staticMetaObject>(),
-    qt_staticMetaObjectStaticContent<qt_meta_tag_ZN10WallDialogE_t>.stringdata,
-    qt_staticMetaObjectStaticContent<qt_meta_tag_ZN10WallDialogE_t>.data,
-    qt_static_metacall,
-    nullptr,
-    qt_staticMetaObjectRelocatingContent<qt_meta_tag_ZN10WallDialogE_t>.metaTypes,
-    nullptr
-} };
-
-void WallDialog::qt_static_metacall(QObject *_o, QMetaObject::Call _c, int _id, void **_a)
-{
-    auto *_t = static_cast<WallDialog *>(_o);
-    if (_c == QMetaObject::InvokeMetaMethod) {
-        switch (_id) {
-        case 0: _t->wallConfigurationChanged(); break;
-        case 1: _t->onMirrorTypeChanged((*reinterpret_cast< std::add_pointer_t<int>>(_a[1]))); break;
-        case 2: _t->applyChanges(); break;
-        case 3: _t->updateWallPreview(); break;
-        default: ;
-        }
-    }
-    if (_c == QMetaObject::IndexOfMethod) {
-        if (QtMocHelpers::indexOfMethod<void (WallDialog::*)()>(_a, &WallDialog::wallConfigurationChanged, 0))
-            return;
-    }
-}
-
-const QMetaObject *WallDialog::metaObject() const
-{
-    return QObject::d_ptr->metaObject ? QObject::d_ptr->dynamicMetaObject() : &staticMetaObject;
-}
-
-void *WallDialog::qt_metacast(const char *_clname)
-{
-    if (!_clname) return nullptr;
-    if (!strcmp(_clname, qt_staticMetaObjectStaticContent<qt_meta_tag_ZN10WallDialogE_t>.strings))
-        return static_cast<void*>(this);
-    return QDialog::qt_metacast(_clname);
-}
-
-int WallDialog::qt_metacall(QMetaObject::Call _c, int _id, void **_a)
-{
-    _id = QDialog::qt_metacall(_c, _id, _a);
-    if (_id < 0)
-        return _id;
-    if (_c == QMetaObject::InvokeMetaMethod) {
-        if (_id < 4)
-            qt_static_metacall(this, _c, _id, _a);
-        _id -= 4;
-    }
-    if (_c == QMetaObject::RegisterMethodArgumentMetaType) {
-        if (_id < 4)
-            *reinterpret_cast<QMetaType *>(_a[0]) = QMetaType();
-        _id -= 4;
-    }
-    return _id;
-}
-
-// SIGNAL 0
-void WallDialog::wallConfigurationChanged()
-{
-    QMetaObject::activate(this, &staticMetaObject, 0, nullptr);
-}
-QT_WARNING_POP
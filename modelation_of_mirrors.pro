@@ -1,77 +1,15 @@
-<<<<<<< HEAD
-QT       += core gui
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-CONFIG += c++17
-
-# You can make your code fail to compile if it uses deprecated APIs.
-# In order to do so, uncomment the following line.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-SOURCES += \
-    lightray.cpp \
-    main.cpp \
-    mainwindow.cpp \
-    mirrorroom.cpp \
-    wall.cpp \
-    walldialog.cpp
-
-HEADERS += \
-    lightray.h \
-    mainwindow.h \
-    mirrorroom.h \
-    wall.h \
-    walldialog.h
-
-FORMS += \
-    mainwindow.ui
-
-TRANSLATIONS += \
-    modelation_of_mirrors_ru_RU.ts
-CONFIG += lrelease
-CONFIG += embed_translations
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
-=======
-QT       += core gui
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-CONFIG += c++17
-
-# You can make your code fail to compile if it uses deprecated APIs.
-# In order to do so, uncomment the following line.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-SOURCES += \
-    lightray.cpp \
-    main.cpp \
-    mainwindow.cpp \
-    mirrorroom.cpp \
-    wall.cpp \
-    walldialog.cpp
-
-HEADERS += \
-    lightray.h \
-    mainwindow.h \
-    mirrorroom.h \
-    wall.h \
-    walldialog.h
-
-FORMS += \
-    mainwindow.ui
-
-TRANSLATIONS += \
-    modelation_of_mirrors_ru_RU.ts
-CONFIG += lrelease
-CONFIG += embed_translations
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
->>>>>>> dbcaaaab8187a40d6d56fbc2b69f275e8cfb3978
+TEMPLATE = subdirs
+
+# core - headless tracing library (QtCore only, no widgets/painting)
+# cli  - mirrortrace command-line driver for display-less runs
+# app  - Qt Widgets GUI, links the same core as the driver
+# tests - QtTest check that SIMD kernels and indexes agree with the scalar scan
+SUBDIRS += \
+    core \
+    cli \
+    app \
+    tests
+
+cli.depends = core
+app.depends = core
+tests.depends = core
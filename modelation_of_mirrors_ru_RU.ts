@@ -1,9 +0,0 @@
-<<<<<<< HEAD
-<?xml version="1.0" encoding="utf-8"?>
-<!DOCTYPE TS>
-<TS version="2.1" language="ru_RU"></TS>
-=======
-<?xml version="1.0" encoding="utf-8"?>
-<!DOCTYPE TS>
-<TS version="2.1" language="ru_RU"></TS>
->>>>>>> dbcaaaab8187a40d6d56fbc2b69f275e8cfb3978
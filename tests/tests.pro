@@ -0,0 +1,22 @@
+QT = core testlib
+
+# make check запускает сверку; после сборки она запускается сразу,
+# и расхождение ядер или структур поиска останавливает сборку
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_kernelcheck
+
+include(../core/core.pri)
+
+# Сверка та же, что у mirrortrace --check-kernels
+INCLUDEPATH += $$PWD/../cli
+
+SOURCES += \
+    ../cli/kernelcheck.cpp \
+    tst_kernelcheck.cpp
+
+HEADERS += \
+    ../cli/kernelcheck.h
+
+!cross_compile: QMAKE_POST_LINK += $$shell_quote($$shell_path($$OUT_PWD/$$TARGET))
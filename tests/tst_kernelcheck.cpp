@@ -0,0 +1,25 @@
+#include <QtTest>
+#include "kernelcheck.h"
+
+// SIMD-ядра, структуры поиска и пакетная трассировка против скалярного перебора:
+// runKernelCheck() печатает отчет и возвращает false при любом расхождении
+class TestKernelCheck : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void kernelsMatchScalar();
+};
+
+void TestKernelCheck::kernelsMatchScalar()
+{
+    QString report;
+    QTextStream out(&report);
+    bool ok = runKernelCheck(out);
+    out.flush();
+    QVERIFY2(ok, qPrintable(report));
+}
+
+QTEST_APPLESS_MAIN(TestKernelCheck)
+
+#include "tst_kernelcheck.moc"